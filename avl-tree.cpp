@@ -1,5 +1,14 @@
 #include <cstdio>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
 
 struct Node {
     Node* parent;
@@ -8,18 +17,101 @@ struct Node {
 
     int value;
     int height;
+    int size;
+    bool pooled;
 
     Node(int x) {
         value = x;
         height = 1;
+        size = 1;
+        pooled = false;
         left = right = parent = nullptr;
     }
 };
 
+class FrozenAVLTree {
+public:
+    FrozenAVLTree(){};
+
+    FrozenAVLTree(const int* sorted, size_t size);
+
+    const int* find(int value) const;
+
+    const int* lowerBound(int value) const;
+
+    template <typename Visitor>
+    void forEachInRange(int lo, int hi, Visitor visitor) const;
+
+    int getHeight() const;
+
+    int getSize() const;
+
+private:
+    static constexpr int kMaxHeight = 64;
+
+    std::vector<int> keys_;
+    size_t size_ = 0;
+    int height_ = 0;
+
+    size_t top_size_[kMaxHeight] = {};
+    size_t bottom_size_[kMaxHeight] = {};
+    int top_depth_[kMaxHeight] = {};
+
+    void buildTables(int depth, int height);
+    void fill(const int* sorted, int depth, uint64_t index, size_t* position);
+    size_t childPosition(const size_t* position, int depth, uint64_t index) const;
+    uint64_t rank(int depth, uint64_t index) const;
+
+    template <typename Visitor>
+    void scan(int lo, int hi, int depth, uint64_t index, size_t* position,
+              Visitor& visitor) const;
+};
+
 class AVLTree {
 public:
+    struct Iterator {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        Iterator(){};
+        Iterator(Node* node, AVLTree* tree) : node_(node), tree_(tree){};
+
+        const int& operator*() const;
+        const int* operator->() const;
+
+        Iterator& operator++();
+        Iterator operator++(int);
+
+        Iterator& operator--();
+        Iterator operator--(int);
+
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        Node* node_ = nullptr;
+        AVLTree* tree_ = nullptr;
+    };
+
     AVLTree();
 
+    AVLTree(AVLTree&& other);
+
+    AVLTree& operator=(AVLTree&& other);
+
+    static AVLTree fromSorted(const int* values, size_t size);
+
+    void insertMany(const int* values, size_t size);
+
+    void unionWith(const AVLTree& other);
+
+    void intersectWith(const AVLTree& other);
+
+    void difference(const AVLTree& other);
+
     int getHeight();
 
     void insert(int value);
@@ -32,12 +124,43 @@ public:
 
     int* lowerBound(int value);
 
+    int* select(int k);
+
+    int rank(int value);
+
+    int countInRange(int lo, int hi);
+
+    Iterator begin();
+
+    Iterator end();
+
+    Iterator upperBound(int value);
+
+    Node* successor(Node* node);
+
+    Node* predecessor(Node* node);
+
+    Node* findNear(int value, Node* finger = nullptr);
+
+    Node* lowerBoundNear(int value, Node* finger = nullptr);
+
+    // Only the search starts at the finger; rebalancing still walks every ancestor to keep
+    // subtree sizes exact, so an insert costs O(log n) however close the finger is.
+    Node* insertNear(int value, Node* finger = nullptr);
+
+    template <typename Visitor>
+    void forEachInRange(int lo, int hi, Visitor visitor);
+
     bool empty();
 
+    FrozenAVLTree freeze();
+
     Node* getRoot();
 
     int getSize();
 
+    void clear();
+
     ~AVLTree();
 
 private:
@@ -45,10 +168,25 @@ private:
     size_t size_ = 0;
 
     Node* root_ = nullptr;
+
+    std::vector<std::pair<Node*, size_t>> blocks_;
+    Node* free_nodes_ = nullptr;
+
+    Node* last_access_ = nullptr;
+
     void setEmptyChildren(Node* node);
 
+    Node* newNode(int value);
+    void releaseNode(Node* node);
+    Node* allocateBlock(size_t count);
+    void releaseBlocks();
+    static Node* placeNode(Node* slot, int value);
+
+    template <typename NodeAt>
+    Node* buildBalanced(NodeAt node_at, size_t begin, size_t end, Node* parent);
+
     void checkBalance(Node* node);
-    void setNodeHeight(Node* node);
+    void updateNode(Node* node);
 
     Node* leftTurn(Node* left_node, Node* right_node);
     Node* smallLeftTurn(Node* left_node, Node* right_node);
@@ -62,18 +200,248 @@ private:
     Node* myFind(int value);
     void symmetric(Node* node, int* i, int* array);
     Node* myErase(Node* node);
+    int countBelow(int value, bool inclusive);
+    Node* firstAbove(int value, bool inclusive);
+    Node* minimum(Node* node);
+    Node* maximum(Node* node);
+
+    Node* insertBelow(Node* current, int value);
+    Node* fingerStart(Node* finger);
+    Node* climb(Node* finger, int value, Node*& bound);
+
+    static constexpr int kParallelCutoff = 1 << 14;
+
+    struct NodeBatch {
+        Node* nodes;
+        size_t count;
+        std::atomic<size_t> used{0};
+
+        Node* take(int value);
+    };
+
+    Node* attach(Node* node, Node* left, Node* right);
+    Node* rotateLeft(Node* node);
+    Node* rotateRight(Node* node);
+
+    Node* join(Node* left, Node* pivot, Node* right);
+    Node* joinLeft(Node* left, Node* pivot, Node* right);
+    Node* joinRight(Node* left, Node* pivot, Node* right);
+    Node* join2(Node* left, Node* right);
+    Node* split(Node* node, int value, Node*& left, Node*& right);
+    Node* splitLast(Node* node, Node*& rest);
+
+    Node* unite(Node* node, Node* other, Node* other_empty, NodeBatch& batch, int depth);
+    Node* intersect(Node* node, Node* other, Node* other_empty, std::vector<Node*>& discarded,
+                    int depth);
+    Node* subtract(Node* node, Node* other, Node* other_empty, std::vector<Node*>& discarded,
+                   int depth);
+    Node* copySubtree(Node* other, Node* other_empty, NodeBatch& batch);
+    void setRoot(Node* node);
+
+    static int forkDepth();
+
+    template <typename LeftTask, typename RightTask>
+    static void forkJoin(bool parallel, LeftTask left_task, RightTask right_task);
 };
 
+const int& AVLTree::Iterator::operator*() const {
+    return node_->value;
+}
+
+const int* AVLTree::Iterator::operator->() const {
+    return &node_->value;
+}
+
+AVLTree::Iterator& AVLTree::Iterator::operator++() {
+    node_ = tree_->successor(node_);
+    return *this;
+}
+
+AVLTree::Iterator AVLTree::Iterator::operator++(int) {
+    Iterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+AVLTree::Iterator& AVLTree::Iterator::operator--() {
+    if (node_ == nullptr) {
+        node_ = tree_->root_ ? tree_->maximum(tree_->root_) : nullptr;
+    } else {
+        node_ = tree_->predecessor(node_);
+    }
+    return *this;
+}
+
+AVLTree::Iterator AVLTree::Iterator::operator--(int) {
+    Iterator copy = *this;
+    --*this;
+    return copy;
+}
+
+bool AVLTree::Iterator::operator==(const Iterator& other) const {
+    return node_ == other.node_;
+}
+
+bool AVLTree::Iterator::operator!=(const Iterator& other) const {
+    return node_ != other.node_;
+}
+
 AVLTree::AVLTree() {
     empty_node_ = new Node(0);
     empty_node_->height = 0;
+    empty_node_->size = 0;
+}
+
+AVLTree::AVLTree(AVLTree&& other) : AVLTree() {
+    *this = std::move(other);
+}
+
+AVLTree& AVLTree::operator=(AVLTree&& other) {
+    std::swap(empty_node_, other.empty_node_);
+    std::swap(size_, other.size_);
+    std::swap(root_, other.root_);
+    std::swap(blocks_, other.blocks_);
+    std::swap(free_nodes_, other.free_nodes_);
+    std::swap(last_access_, other.last_access_);
+    return *this;
 }
 
 AVLTree::~AVLTree() {
-    clear(root_);
+    clear();
     delete empty_node_;
 }
 
+AVLTree AVLTree::fromSorted(const int* values, size_t size) {
+    AVLTree tree;
+
+    size_t unique = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (i == 0 || values[i] != values[i - 1]) {
+            ++unique;
+        }
+    }
+    if (unique == 0) {
+        return tree;
+    }
+
+    Node* block = tree.allocateBlock(unique);
+    for (size_t i = 0, j = 0; i < size; ++i) {
+        if (i == 0 || values[i] != values[i - 1]) {
+            placeNode(block + j++, values[i]);
+        }
+    }
+
+    tree.root_ = tree.buildBalanced([block](size_t i) { return block + i; }, 0, unique, nullptr);
+    tree.size_ = unique;
+    return tree;
+}
+
+void AVLTree::insertMany(const int* values, size_t size) {
+    std::vector<int> sorted(values, values + size);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    size_t log_size = 1;
+    while ((size_t(1) << log_size) < size_) {
+        ++log_size;
+    }
+    if (sorted.size() * log_size < size_) {
+        for (int value : sorted) {
+            insert(value);
+        }
+        return;
+    }
+
+    std::vector<int> fresh;
+    for (int value : sorted) {
+        if (myFind(value) == nullptr) {
+            fresh.push_back(value);
+        }
+    }
+    if (fresh.empty()) {
+        return;
+    }
+
+    Node* block = allocateBlock(fresh.size());
+    std::vector<Node*> merged;
+    merged.reserve(size_ + fresh.size());
+
+    Node* current = root_ ? minimum(root_) : nullptr;
+    size_t next_fresh = 0;
+    while (current || next_fresh < fresh.size()) {
+        if (next_fresh < fresh.size() && (!current || fresh[next_fresh] < current->value)) {
+            merged.push_back(placeNode(block + next_fresh, fresh[next_fresh]));
+            ++next_fresh;
+        } else {
+            merged.push_back(current);
+            current = successor(current);
+        }
+    }
+
+    root_ = buildBalanced([&merged](size_t i) { return merged[i]; }, 0, merged.size(), nullptr);
+    size_ = merged.size();
+}
+
+template <typename NodeAt>
+Node* AVLTree::buildBalanced(NodeAt node_at, size_t begin, size_t end, Node* parent) {
+    if (begin == end) {
+        return empty_node_;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+    Node* node = node_at(middle);
+    node->parent = parent;
+    node->left = buildBalanced(node_at, begin, middle, node);
+    node->right = buildBalanced(node_at, middle + 1, end, node);
+    updateNode(node);
+
+    return node;
+}
+
+Node* AVLTree::allocateBlock(size_t count) {
+    Node* block = static_cast<Node*>(::operator new(count * sizeof(Node)));
+    blocks_.emplace_back(block, count);
+    return block;
+}
+
+Node* AVLTree::newNode(int value) {
+    if (free_nodes_ == nullptr) {
+        return new Node(value);
+    }
+
+    Node* node = free_nodes_;
+    free_nodes_ = free_nodes_->left;
+    return placeNode(node, value);
+}
+
+Node* AVLTree::placeNode(Node* slot, int value) {
+    Node* node = new (slot) Node(value);
+    node->pooled = true;
+    return node;
+}
+
+void AVLTree::releaseNode(Node* node) {
+    if (node == last_access_) {
+        last_access_ = nullptr;
+    }
+
+    if (node->pooled) {
+        node->left = free_nodes_;
+        free_nodes_ = node;
+    } else {
+        delete node;
+    }
+}
+
+// Only valid once no live node sits in a block, i.e. when the tree is empty.
+void AVLTree::releaseBlocks() {
+    for (auto& [block, count] : blocks_) {
+        ::operator delete(block);
+    }
+    blocks_.clear();
+    free_nodes_ = nullptr;
+}
+
 bool AVLTree::empty() {
     return size_ == 0;
 }
@@ -82,46 +450,44 @@ int AVLTree::getSize() {
     return size_;
 }
 
+void AVLTree::clear() {
+    clear(root_);
+    root_ = nullptr;
+    size_ = 0;
+    releaseBlocks();
+}
+
 Node* AVLTree::getRoot() {
     return root_;
 }
 
 void AVLTree::insert(int value) {
     if (root_ == nullptr) {
-        root_ = new Node(value);
+        root_ = newNode(value);
         setEmptyChildren(root_);
 
         size_ = 1;
     } else {
-        Node* current = root_;
-        while (value != current->value) {
-            if (value < current->value) {
-                if (current->left == empty_node_) {
-                    current->left = new Node(value);
-                    current->left->parent = current;
-                    setEmptyChildren(current->left);
-
-                    checkBalance(current);
-                    ++size_;
-                    return;
-                } else {
-                    current = current->left;
-                }
-            } else if (value > current->value) {
-                if (current->right == empty_node_) {
-                    current->right = new Node(value);
-                    current->right->parent = current;
-                    setEmptyChildren(current->right);
-
-                    checkBalance(current);
-                    ++size_;
-                    return;
-                } else {
-                    current = current->right;
-                }
-            }
+        insertBelow(root_, value);
+    }
+}
+
+Node* AVLTree::insertBelow(Node* current, int value) {
+    while (value != current->value) {
+        Node*& child = value < current->value ? current->left : current->right;
+        if (child == empty_node_) {
+            child = newNode(value);
+            child->parent = current;
+            setEmptyChildren(child);
+
+            Node* inserted = child;
+            checkBalance(current);
+            ++size_;
+            return inserted;
         }
+        current = child;
     }
+    return current;
 }
 
 void AVLTree::checkBalance(Node* node) {
@@ -131,7 +497,7 @@ void AVLTree::checkBalance(Node* node) {
         node = rightTurn(node->left, node);
     }
 
-    setNodeHeight(node);
+    updateNode(node);
 
     if (node->parent != nullptr) {
         checkBalance(node->parent);
@@ -163,8 +529,8 @@ Node* AVLTree::smallLeftTurn(Node* left_node, Node* right_node) {
         right_node->parent->left = right_node;
     }
 
-    setNodeHeight(left_node);
-    setNodeHeight(right_node);
+    updateNode(left_node);
+    updateNode(right_node);
 
     return right_node;
 }
@@ -179,9 +545,11 @@ Node* AVLTree::bigLeftTurn(Node* left_node, Node* right_node) {
 
     left_node->parent = middle_node;
     left_node->right = middle_node->left;
+    left_node->right->parent = left_node;
 
     right_node->parent = middle_node;
     right_node->left = middle_node->right;
+    right_node->left->parent = right_node;
 
     middle_node->left = left_node;
     middle_node->right = right_node;
@@ -192,9 +560,9 @@ Node* AVLTree::bigLeftTurn(Node* left_node, Node* right_node) {
         middle_node->parent->left = middle_node;
     }
 
-    setNodeHeight(left_node);
-    setNodeHeight(right_node);
-    setNodeHeight(middle_node);
+    updateNode(left_node);
+    updateNode(right_node);
+    updateNode(middle_node);
 
     return middle_node;
 }
@@ -215,7 +583,7 @@ Node* AVLTree::smallRightTurn(Node* left_node, Node* right_node) {
     left_node->parent = right_node->parent;
     right_node->parent = left_node;
     right_node->left = left_node->right;
-    left_node->right->parent = right_node->left;
+    right_node->left->parent = right_node;
     left_node->right = right_node;
 
     if (left_node->parent && left_node->parent->value < left_node->value) {
@@ -224,8 +592,8 @@ Node* AVLTree::smallRightTurn(Node* left_node, Node* right_node) {
         left_node->parent->left = left_node;
     }
 
-    setNodeHeight(left_node);
-    setNodeHeight(right_node);
+    updateNode(right_node);
+    updateNode(left_node);
 
     return left_node;
 }
@@ -240,9 +608,11 @@ Node* AVLTree::bigRightTurn(Node* left_node, Node* right_node) {
 
     right_node->parent = middle_node;
     right_node->left = middle_node->right;
+    right_node->left->parent = right_node;
 
     left_node->parent = middle_node;
     left_node->right = middle_node->left;
+    left_node->right->parent = left_node;
 
     middle_node->left = left_node;
     middle_node->right = right_node;
@@ -253,9 +623,9 @@ Node* AVLTree::bigRightTurn(Node* left_node, Node* right_node) {
         middle_node->parent->left = middle_node;
     }
 
-    setNodeHeight(left_node);
-    setNodeHeight(right_node);
-    setNodeHeight(middle_node);
+    updateNode(left_node);
+    updateNode(right_node);
+    updateNode(middle_node);
 
     return middle_node;
 }
@@ -265,15 +635,16 @@ void AVLTree::setEmptyChildren(Node* node) {
     node->right = empty_node_;
 }
 
-void AVLTree::setNodeHeight(Node* node) {
+void AVLTree::updateNode(Node* node) {
     node->height = std::max(node->left->height, node->right->height) + 1;
+    node->size = node->left->size + node->right->size + 1;
 }
 
 void AVLTree::clear(Node* root) {
     if (root != nullptr && root != empty_node_) {
         clear(root->left);
         clear(root->right);
-        delete root;
+        releaseNode(root);
     }
 }
 
@@ -295,6 +666,10 @@ void AVLTree::erase(int value) {
         checkBalance(to_balance);
     }
     --size_;
+
+    if (size_ == 0) {
+        releaseBlocks();
+    }
 }
 
 Node* AVLTree::myErase(Node* node) {
@@ -310,7 +685,7 @@ Node* AVLTree::myErase(Node* node) {
         }
 
         Node* to_return = node->parent;
-        delete node;
+        releaseNode(node);
         return to_return;
     } else if (node->left != empty_node_ && node->right == empty_node_) {
         Node* left_node = node->left;
@@ -329,7 +704,7 @@ Node* AVLTree::myErase(Node* node) {
             root_ = left_node;
         }
 
-        delete node;
+        releaseNode(node);
         return left_node;
     } else if (node->left == empty_node_ && node->right != empty_node_) {
         Node* right_node = node->right;
@@ -348,7 +723,7 @@ Node* AVLTree::myErase(Node* node) {
             root_ = right_node;
         }
 
-        delete node;
+        releaseNode(node);
         return right_node;
     } else {
         Node* to_replace = node;
@@ -387,7 +762,7 @@ Node* AVLTree::myErase(Node* node) {
             root_ = to_replace;
         }
 
-        delete node;
+        releaseNode(node);
         return to_return;
     }
 }
@@ -474,3 +849,662 @@ int* AVLTree::lowerBound(int value) {
         return nullptr;
     }
 }
+
+int* AVLTree::select(int k) {
+    if (k < 0 || k >= static_cast<int>(size_)) {
+        return nullptr;
+    }
+
+    Node* current = root_;
+    while (current != empty_node_) {
+        int left_size = current->left->size;
+        if (k < left_size) {
+            current = current->left;
+        } else if (k == left_size) {
+            return &current->value;
+        } else {
+            k -= left_size + 1;
+            current = current->right;
+        }
+    }
+    return nullptr;
+}
+
+int AVLTree::rank(int value) {
+    return countBelow(value, false);
+}
+
+int AVLTree::countInRange(int lo, int hi) {
+    if (lo > hi) {
+        return 0;
+    }
+    return countBelow(hi, true) - countBelow(lo, false);
+}
+
+int AVLTree::countBelow(int value, bool inclusive) {
+    int count = 0;
+    Node* current = root_;
+    while (current != nullptr && current != empty_node_) {
+        if (current->value < value || (inclusive && current->value == value)) {
+            count += current->left->size + 1;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return count;
+}
+
+AVLTree::Iterator AVLTree::begin() {
+    return Iterator(root_ ? minimum(root_) : nullptr, this);
+}
+
+AVLTree::Iterator AVLTree::end() {
+    return Iterator(nullptr, this);
+}
+
+AVLTree::Iterator AVLTree::upperBound(int value) {
+    return Iterator(firstAbove(value, false), this);
+}
+
+Node* AVLTree::successor(Node* node) {
+    if (node->right != empty_node_) {
+        return minimum(node->right);
+    }
+    while (node->parent && node->parent->right == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+Node* AVLTree::predecessor(Node* node) {
+    if (node->left != empty_node_) {
+        return maximum(node->left);
+    }
+    while (node->parent && node->parent->left == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+template <typename Visitor>
+void AVLTree::forEachInRange(int lo, int hi, Visitor visitor) {
+    for (Node* current = firstAbove(lo, true); current && current->value <= hi;
+         current = successor(current)) {
+        visitor(current->value);
+    }
+}
+
+Node* AVLTree::firstAbove(int value, bool inclusive) {
+    Node* found = nullptr;
+    Node* current = root_;
+    while (current != nullptr && current != empty_node_) {
+        if (current->value > value || (inclusive && current->value == value)) {
+            found = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return found;
+}
+
+Node* AVLTree::minimum(Node* node) {
+    while (node->left != empty_node_) {
+        node = node->left;
+    }
+    return node;
+}
+
+Node* AVLTree::maximum(Node* node) {
+    while (node->right != empty_node_) {
+        node = node->right;
+    }
+    return node;
+}
+
+void AVLTree::unionWith(const AVLTree& other) {
+    if (&other == this || other.root_ == nullptr) {
+        return;
+    }
+
+    NodeBatch batch{allocateBlock(other.size_), other.size_};
+    setRoot(unite(root_ ? root_ : empty_node_, other.root_, other.empty_node_, batch,
+                  forkDepth()));
+
+    for (size_t i = batch.used.load(); i < batch.count; ++i) {
+        batch.nodes[i].left = free_nodes_;
+        free_nodes_ = batch.nodes + i;
+    }
+}
+
+void AVLTree::intersectWith(const AVLTree& other) {
+    if (&other == this || root_ == nullptr) {
+        return;
+    }
+
+    std::vector<Node*> discarded;
+    setRoot(intersect(root_, other.root_ ? other.root_ : other.empty_node_, other.empty_node_,
+                      discarded, forkDepth()));
+    for (Node* node : discarded) {
+        clear(node);
+    }
+    if (root_ == nullptr) {
+        releaseBlocks();
+    }
+}
+
+void AVLTree::difference(const AVLTree& other) {
+    if (root_ == nullptr || other.root_ == nullptr) {
+        return;
+    }
+    if (&other == this) {
+        clear();
+        return;
+    }
+
+    std::vector<Node*> discarded;
+    setRoot(subtract(root_, other.root_, other.empty_node_, discarded, forkDepth()));
+    for (Node* node : discarded) {
+        clear(node);
+    }
+    if (root_ == nullptr) {
+        releaseBlocks();
+    }
+}
+
+Node* AVLTree::NodeBatch::take(int value) {
+    return placeNode(nodes + used.fetch_add(1, std::memory_order_relaxed), value);
+}
+
+Node* AVLTree::attach(Node* node, Node* left, Node* right) {
+    node->left = left;
+    node->right = right;
+    if (left != empty_node_) {
+        left->parent = node;
+    }
+    if (right != empty_node_) {
+        right->parent = node;
+    }
+    updateNode(node);
+    return node;
+}
+
+Node* AVLTree::rotateLeft(Node* node) {
+    Node* right_node = node->right;
+    attach(node, node->left, right_node->left);
+    return attach(right_node, node, right_node->right);
+}
+
+Node* AVLTree::rotateRight(Node* node) {
+    Node* left_node = node->left;
+    attach(node, left_node->right, node->right);
+    return attach(left_node, left_node->left, node);
+}
+
+Node* AVLTree::join(Node* left, Node* pivot, Node* right) {
+    if (left->height > right->height + 1) {
+        return joinRight(left, pivot, right);
+    }
+    if (right->height > left->height + 1) {
+        return joinLeft(left, pivot, right);
+    }
+    return attach(pivot, left, right);
+}
+
+Node* AVLTree::joinRight(Node* left, Node* pivot, Node* right) {
+    Node* child = left->right;
+    if (child->height <= right->height + 1) {
+        Node* joined = attach(pivot, child, right);
+        if (joined->height <= left->left->height + 1) {
+            return attach(left, left->left, joined);
+        }
+        return rotateLeft(attach(left, left->left, rotateRight(joined)));
+    }
+
+    Node* joined = joinRight(child, pivot, right);
+    attach(left, left->left, joined);
+    if (joined->height <= left->left->height + 1) {
+        return left;
+    }
+    return rotateLeft(left);
+}
+
+Node* AVLTree::joinLeft(Node* left, Node* pivot, Node* right) {
+    Node* child = right->left;
+    if (child->height <= left->height + 1) {
+        Node* joined = attach(pivot, left, child);
+        if (joined->height <= right->right->height + 1) {
+            return attach(right, joined, right->right);
+        }
+        return rotateRight(attach(right, rotateLeft(joined), right->right));
+    }
+
+    Node* joined = joinLeft(left, pivot, child);
+    attach(right, joined, right->right);
+    if (joined->height <= right->right->height + 1) {
+        return right;
+    }
+    return rotateRight(right);
+}
+
+Node* AVLTree::join2(Node* left, Node* right) {
+    if (left == empty_node_) {
+        return right;
+    }
+
+    Node* rest;
+    Node* last = splitLast(left, rest);
+    return join(rest, last, right);
+}
+
+Node* AVLTree::split(Node* node, int value, Node*& left, Node*& right) {
+    if (node == empty_node_) {
+        left = right = empty_node_;
+        return nullptr;
+    }
+
+    if (value == node->value) {
+        left = node->left;
+        right = node->right;
+        return node;
+    }
+
+    Node* found;
+    if (value < node->value) {
+        Node* tail;
+        found = split(node->left, value, left, tail);
+        right = join(tail, node, node->right);
+    } else {
+        Node* head;
+        found = split(node->right, value, head, right);
+        left = join(node->left, node, head);
+    }
+    return found;
+}
+
+Node* AVLTree::splitLast(Node* node, Node*& rest) {
+    if (node->right == empty_node_) {
+        rest = node->left;
+        return node;
+    }
+
+    Node* tail;
+    Node* last = splitLast(node->right, tail);
+    rest = join(node->left, node, tail);
+    return last;
+}
+
+Node* AVLTree::unite(Node* node, Node* other, Node* other_empty, NodeBatch& batch, int depth) {
+    if (other == other_empty) {
+        return node;
+    }
+    if (node == empty_node_) {
+        return copySubtree(other, other_empty, batch);
+    }
+
+    Node* left;
+    Node* right;
+    Node* found = split(node, other->value, left, right);
+    Node* pivot = found ? found : batch.take(other->value);
+
+    bool parallel = depth > 0 && node->size + other->size >= kParallelCutoff;
+    forkJoin(
+        parallel,
+        [&] { left = unite(left, other->left, other_empty, batch, depth - 1); },
+        [&] { right = unite(right, other->right, other_empty, batch, depth - 1); });
+
+    return join(left, pivot, right);
+}
+
+Node* AVLTree::intersect(Node* node, Node* other, Node* other_empty,
+                         std::vector<Node*>& discarded, int depth) {
+    if (node == empty_node_) {
+        return node;
+    }
+    if (other == other_empty) {
+        discarded.push_back(node);
+        return empty_node_;
+    }
+
+    Node* left;
+    Node* right;
+    Node* found = split(node, other->value, left, right);
+
+    bool parallel = depth > 0 && node->size + other->size >= kParallelCutoff;
+    std::vector<Node*> right_discarded;
+    forkJoin(
+        parallel,
+        [&] { left = intersect(left, other->left, other_empty, discarded, depth - 1); },
+        [&] { right = intersect(right, other->right, other_empty, right_discarded, depth - 1); });
+    discarded.insert(discarded.end(), right_discarded.begin(), right_discarded.end());
+
+    if (found) {
+        return join(left, found, right);
+    }
+    return join2(left, right);
+}
+
+Node* AVLTree::subtract(Node* node, Node* other, Node* other_empty,
+                        std::vector<Node*>& discarded, int depth) {
+    if (node == empty_node_ || other == other_empty) {
+        return node;
+    }
+
+    Node* left;
+    Node* right;
+    Node* found = split(node, other->value, left, right);
+
+    bool parallel = depth > 0 && node->size + other->size >= kParallelCutoff;
+    std::vector<Node*> right_discarded;
+    forkJoin(
+        parallel,
+        [&] { left = subtract(left, other->left, other_empty, discarded, depth - 1); },
+        [&] { right = subtract(right, other->right, other_empty, right_discarded, depth - 1); });
+    discarded.insert(discarded.end(), right_discarded.begin(), right_discarded.end());
+
+    if (found) {
+        setEmptyChildren(found);
+        discarded.push_back(found);
+    }
+    return join2(left, right);
+}
+
+Node* AVLTree::copySubtree(Node* other, Node* other_empty, NodeBatch& batch) {
+    if (other == other_empty) {
+        return empty_node_;
+    }
+
+    Node* node = batch.take(other->value);
+    return attach(node, copySubtree(other->left, other_empty, batch),
+                  copySubtree(other->right, other_empty, batch));
+}
+
+void AVLTree::setRoot(Node* node) {
+    if (node == empty_node_) {
+        root_ = nullptr;
+        size_ = 0;
+        return;
+    }
+
+    root_ = node;
+    root_->parent = nullptr;
+    size_ = node->size;
+}
+
+int AVLTree::forkDepth() {
+    unsigned threads = std::thread::hardware_concurrency();
+    int depth = 0;
+    while ((1u << depth) < threads) {
+        ++depth;
+    }
+    return depth;
+}
+
+template <typename LeftTask, typename RightTask>
+void AVLTree::forkJoin(bool parallel, LeftTask left_task, RightTask right_task) {
+    if (!parallel) {
+        left_task();
+        right_task();
+        return;
+    }
+
+    std::thread worker(left_task);
+    right_task();
+    worker.join();
+}
+
+Node* AVLTree::findNear(int value, Node* finger) {
+    Node* current = fingerStart(finger);
+    if (current == nullptr) {
+        return nullptr;
+    }
+
+    Node* bound;
+    current = climb(current, value, bound);
+
+    Node* last = current;
+    while (current != empty_node_) {
+        last = current;
+        if (value == current->value) {
+            last_access_ = current;
+            return current;
+        }
+        current = value < current->value ? current->left : current->right;
+    }
+
+    last_access_ = last;
+    return nullptr;
+}
+
+Node* AVLTree::lowerBoundNear(int value, Node* finger) {
+    Node* current = fingerStart(finger);
+    if (current == nullptr) {
+        return nullptr;
+    }
+
+    Node* found;
+    current = climb(current, value, found);
+
+    Node* last = current;
+    while (current != empty_node_) {
+        last = current;
+        if (current->value >= value) {
+            found = current;
+            if (current->value == value) {
+                break;
+            }
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+
+    last_access_ = found ? found : last;
+    return found;
+}
+
+Node* AVLTree::insertNear(int value, Node* finger) {
+    Node* current = fingerStart(finger);
+    if (current == nullptr) {
+        insert(value);
+        last_access_ = root_;
+        return root_;
+    }
+
+    Node* bound;
+    current = climb(current, value, bound);
+
+    last_access_ = insertBelow(current, value);
+    return last_access_;
+}
+
+Node* AVLTree::fingerStart(Node* finger) {
+    if (finger == nullptr) {
+        finger = last_access_;
+    }
+    if (finger == nullptr) {
+        finger = root_;
+    }
+    return finger;
+}
+
+Node* AVLTree::climb(Node* finger, int value, Node*& bound) {
+    bound = nullptr;
+
+    Node* current = finger;
+    if (value > current->value) {
+        while (current->parent) {
+            Node* parent = current->parent;
+            if (parent->left == current && value <= parent->value) {
+                if (value == parent->value) {
+                    current = parent;
+                } else {
+                    bound = parent;
+                }
+                break;
+            }
+            current = parent;
+        }
+    } else if (value < current->value) {
+        while (current->parent) {
+            Node* parent = current->parent;
+            if (parent->right == current && value >= parent->value) {
+                if (value == parent->value) {
+                    current = parent;
+                }
+                break;
+            }
+            current = parent;
+        }
+    }
+
+    return current;
+}
+
+FrozenAVLTree AVLTree::freeze() {
+    int* sorted = traversal();
+    FrozenAVLTree frozen(sorted, size_);
+    delete[] sorted;
+    return frozen;
+}
+
+FrozenAVLTree::FrozenAVLTree(const int* sorted, size_t size) : size_(size) {
+    while ((uint64_t(1) << height_) - 1 < size) {
+        ++height_;
+    }
+    if (height_ == 0) {
+        return;
+    }
+
+    keys_.resize((uint64_t(1) << height_) - 1);
+    buildTables(0, height_);
+
+    size_t position[kMaxHeight];
+    position[0] = 0;
+    fill(sorted, 0, 1, position);
+}
+
+void FrozenAVLTree::buildTables(int depth, int height) {
+    if (height <= 1) {
+        return;
+    }
+
+    int top_height = height / 2;
+    int bottom_depth = depth + top_height;
+    top_size_[bottom_depth] = (uint64_t(1) << top_height) - 1;
+    bottom_size_[bottom_depth] = (uint64_t(1) << (height - top_height)) - 1;
+    top_depth_[bottom_depth] = depth;
+
+    buildTables(depth, top_height);
+    buildTables(bottom_depth, height - top_height);
+}
+
+void FrozenAVLTree::fill(const int* sorted, int depth, uint64_t index, size_t* position) {
+    uint64_t node_rank = rank(depth, index);
+    keys_[position[depth]] = node_rank < size_ ? sorted[node_rank] : INT_MAX;
+
+    if (depth + 1 < height_) {
+        for (uint64_t child = 2 * index; child <= 2 * index + 1; ++child) {
+            position[depth + 1] = childPosition(position, depth + 1, child);
+            fill(sorted, depth + 1, child, position);
+        }
+    }
+}
+
+size_t FrozenAVLTree::childPosition(const size_t* position, int depth, uint64_t index) const {
+    size_t top_size = top_size_[depth];
+    return position[top_depth_[depth]] + top_size + (index & top_size) * bottom_size_[depth];
+}
+
+uint64_t FrozenAVLTree::rank(int depth, uint64_t index) const {
+    uint64_t offset = index - (uint64_t(1) << depth);
+    return ((2 * offset + 1) << (height_ - 1 - depth)) - 1;
+}
+
+const int* FrozenAVLTree::find(int value) const {
+    const int* found = lowerBound(value);
+    if (found && *found == value) {
+        return found;
+    }
+    return nullptr;
+}
+
+const int* FrozenAVLTree::lowerBound(int value) const {
+    if (height_ == 0) {
+        return nullptr;
+    }
+
+    size_t position[kMaxHeight];
+    position[0] = 0;
+    uint64_t index = 1;
+
+    int found_depth = -1;
+    uint64_t found_index = 0;
+
+    for (int depth = 0;; ++depth) {
+        if (depth + 1 < height_) {
+            __builtin_prefetch(&keys_[childPosition(position, depth + 1, 2 * index)]);
+            __builtin_prefetch(&keys_[childPosition(position, depth + 1, 2 * index + 1)]);
+        }
+
+        bool go_left = keys_[position[depth]] >= value;
+        if (go_left) {
+            found_depth = depth;
+            found_index = index;
+        }
+
+        if (depth + 1 == height_) {
+            break;
+        }
+        index = 2 * index + (go_left ? 0 : 1);
+        position[depth + 1] = childPosition(position, depth + 1, index);
+    }
+
+    if (found_depth < 0 || rank(found_depth, found_index) >= size_) {
+        return nullptr;
+    }
+    return &keys_[position[found_depth]];
+}
+
+template <typename Visitor>
+void FrozenAVLTree::forEachInRange(int lo, int hi, Visitor visitor) const {
+    if (height_ == 0 || lo > hi) {
+        return;
+    }
+
+    size_t position[kMaxHeight];
+    position[0] = 0;
+    scan(lo, hi, 0, 1, position, visitor);
+}
+
+template <typename Visitor>
+void FrozenAVLTree::scan(int lo, int hi, int depth, uint64_t index, size_t* position,
+                         Visitor& visitor) const {
+    int key = keys_[position[depth]];
+    bool padding = rank(depth, index) >= size_;
+
+    if (depth + 1 < height_ && (padding || key >= lo)) {
+        position[depth + 1] = childPosition(position, depth + 1, 2 * index);
+        scan(lo, hi, depth + 1, 2 * index, position, visitor);
+    }
+    if (padding) {
+        return;
+    }
+
+    if (key >= lo && key <= hi) {
+        visitor(key);
+    }
+    if (depth + 1 < height_ && key < hi) {
+        position[depth + 1] = childPosition(position, depth + 1, 2 * index + 1);
+        scan(lo, hi, depth + 1, 2 * index + 1, position, visitor);
+    }
+}
+
+int FrozenAVLTree::getHeight() const {
+    return height_;
+}
+
+int FrozenAVLTree::getSize() const {
+    return size_;
+}
@@ -0,0 +1,282 @@
+#include <cstdio>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+struct CompactNode {
+    int value;
+    uint32_t left;
+    uint32_t right;
+    int8_t height;
+};
+
+static_assert(sizeof(CompactNode) <= 16);
+
+class CompactAVLTree {
+public:
+    CompactAVLTree();
+
+    explicit CompactAVLTree(size_t capacity);
+
+    void reserve(size_t capacity);
+
+    int getHeight();
+
+    void insert(int value);
+
+    void erase(int value);
+
+    int* find(int value);
+
+    int* traversal();
+
+    int* lowerBound(int value);
+
+    bool empty();
+
+    int getSize();
+
+    void clear();
+
+private:
+    static constexpr uint32_t kEmpty = 0;
+
+    std::vector<CompactNode> nodes_;
+    uint32_t root_ = kEmpty;
+    uint32_t free_ = kEmpty;
+    size_t size_ = 0;
+
+    uint32_t allocate(int value);
+    void release(uint32_t node);
+
+    void updateNode(uint32_t node);
+    int balanceFactor(uint32_t node);
+    uint32_t rotateLeft(uint32_t node);
+    uint32_t rotateRight(uint32_t node);
+    uint32_t rebalance(uint32_t node);
+
+    uint32_t insertAt(uint32_t node, int value);
+    uint32_t eraseAt(uint32_t node, int value);
+    uint32_t detachMinimum(uint32_t node, uint32_t& minimum);
+    void symmetric(uint32_t node, int* i, int* array);
+};
+
+CompactAVLTree::CompactAVLTree() {
+    nodes_.push_back(CompactNode{0, kEmpty, kEmpty, 0});
+}
+
+CompactAVLTree::CompactAVLTree(size_t capacity) : CompactAVLTree() {
+    reserve(capacity);
+}
+
+void CompactAVLTree::reserve(size_t capacity) {
+    nodes_.reserve(capacity + 1);
+}
+
+int CompactAVLTree::getHeight() {
+    return nodes_[root_].height;
+}
+
+bool CompactAVLTree::empty() {
+    return size_ == 0;
+}
+
+int CompactAVLTree::getSize() {
+    return size_;
+}
+
+void CompactAVLTree::clear() {
+    nodes_.resize(1);
+    root_ = kEmpty;
+    free_ = kEmpty;
+    size_ = 0;
+}
+
+uint32_t CompactAVLTree::allocate(int value) {
+    uint32_t node = free_;
+    if (node != kEmpty) {
+        free_ = nodes_[node].left;
+    } else {
+        if (nodes_.size() > UINT32_MAX) {
+            throw std::runtime_error("Tree is full!");
+        }
+        node = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    nodes_[node] = CompactNode{value, kEmpty, kEmpty, 1};
+    return node;
+}
+
+void CompactAVLTree::release(uint32_t node) {
+    nodes_[node].left = free_;
+    free_ = node;
+}
+
+void CompactAVLTree::updateNode(uint32_t node) {
+    CompactNode& current = nodes_[node];
+    current.height = std::max(nodes_[current.left].height, nodes_[current.right].height) + 1;
+}
+
+int CompactAVLTree::balanceFactor(uint32_t node) {
+    return nodes_[nodes_[node].right].height - nodes_[nodes_[node].left].height;
+}
+
+uint32_t CompactAVLTree::rotateLeft(uint32_t node) {
+    uint32_t right_node = nodes_[node].right;
+    nodes_[node].right = nodes_[right_node].left;
+    nodes_[right_node].left = node;
+
+    updateNode(node);
+    updateNode(right_node);
+
+    return right_node;
+}
+
+uint32_t CompactAVLTree::rotateRight(uint32_t node) {
+    uint32_t left_node = nodes_[node].left;
+    nodes_[node].left = nodes_[left_node].right;
+    nodes_[left_node].right = node;
+
+    updateNode(node);
+    updateNode(left_node);
+
+    return left_node;
+}
+
+uint32_t CompactAVLTree::rebalance(uint32_t node) {
+    updateNode(node);
+
+    int balance = balanceFactor(node);
+    if (balance > 1) {
+        if (balanceFactor(nodes_[node].right) < 0) {
+            nodes_[node].right = rotateRight(nodes_[node].right);
+        }
+        return rotateLeft(node);
+    }
+    if (balance < -1) {
+        if (balanceFactor(nodes_[node].left) > 0) {
+            nodes_[node].left = rotateLeft(nodes_[node].left);
+        }
+        return rotateRight(node);
+    }
+
+    return node;
+}
+
+void CompactAVLTree::insert(int value) {
+    if (find(value) != nullptr) {
+        return;
+    }
+
+    root_ = insertAt(root_, value);
+    ++size_;
+}
+
+uint32_t CompactAVLTree::insertAt(uint32_t node, int value) {
+    if (node == kEmpty) {
+        return allocate(value);
+    }
+
+    if (value < nodes_[node].value) {
+        uint32_t left_node = insertAt(nodes_[node].left, value);
+        nodes_[node].left = left_node;
+    } else {
+        uint32_t right_node = insertAt(nodes_[node].right, value);
+        nodes_[node].right = right_node;
+    }
+
+    return rebalance(node);
+}
+
+void CompactAVLTree::erase(int value) {
+    if (find(value) == nullptr) {
+        return;
+    }
+
+    root_ = eraseAt(root_, value);
+    --size_;
+}
+
+uint32_t CompactAVLTree::eraseAt(uint32_t node, int value) {
+    if (value < nodes_[node].value) {
+        nodes_[node].left = eraseAt(nodes_[node].left, value);
+        return rebalance(node);
+    }
+    if (value > nodes_[node].value) {
+        nodes_[node].right = eraseAt(nodes_[node].right, value);
+        return rebalance(node);
+    }
+
+    uint32_t left_node = nodes_[node].left;
+    uint32_t right_node = nodes_[node].right;
+    release(node);
+
+    if (right_node == kEmpty) {
+        return left_node;
+    }
+
+    uint32_t minimum;
+    right_node = detachMinimum(right_node, minimum);
+    nodes_[minimum].left = left_node;
+    nodes_[minimum].right = right_node;
+
+    return rebalance(minimum);
+}
+
+uint32_t CompactAVLTree::detachMinimum(uint32_t node, uint32_t& minimum) {
+    if (nodes_[node].left == kEmpty) {
+        minimum = node;
+        return nodes_[node].right;
+    }
+
+    nodes_[node].left = detachMinimum(nodes_[node].left, minimum);
+    return rebalance(node);
+}
+
+int* CompactAVLTree::find(int value) {
+    uint32_t current = root_;
+    while (current != kEmpty) {
+        CompactNode& node = nodes_[current];
+        if (value == node.value) {
+            return &node.value;
+        }
+        current = value < node.value ? node.left : node.right;
+    }
+    return nullptr;
+}
+
+int* CompactAVLTree::lowerBound(int value) {
+    int* found = nullptr;
+    uint32_t current = root_;
+    while (current != kEmpty) {
+        CompactNode& node = nodes_[current];
+        if (node.value >= value) {
+            found = &node.value;
+            current = node.left;
+        } else {
+            current = node.right;
+        }
+    }
+    return found;
+}
+
+int* CompactAVLTree::traversal() {
+    int* array = new int[size_];
+    int i = 0;
+
+    symmetric(root_, &i, array);
+
+    return array;
+}
+
+void CompactAVLTree::symmetric(uint32_t node, int* i, int* array) {
+    if (node == kEmpty) {
+        return;
+    }
+    symmetric(nodes_[node].left, i, array);
+    array[*i] = nodes_[node].value;
+    ++*i;
+    symmetric(nodes_[node].right, i, array);
+}
@@ -0,0 +1,966 @@
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+class ConcurrentAVLTree {
+public:
+    // Pins the current epoch: nodes unlinked while a Guard is alive are not freed
+    // until it is destroyed.
+    class Guard {
+    public:
+        explicit Guard(ConcurrentAVLTree& tree);
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard();
+
+    private:
+        ConcurrentAVLTree& tree_;
+        uint64_t epoch_;
+    };
+
+    ConcurrentAVLTree();
+
+    ConcurrentAVLTree(const ConcurrentAVLTree&) = delete;
+    ConcurrentAVLTree& operator=(const ConcurrentAVLTree&) = delete;
+
+    ~ConcurrentAVLTree();
+
+    bool insert(int value);
+
+    bool erase(int value);
+
+    // The returned pointer is only valid while the caller holds a Guard on this tree.
+    const int* find(int value);
+
+    const int* lowerBound(int value);
+
+    bool empty();
+
+    int getSize();
+
+private:
+    struct Node {
+        const int key;
+        std::atomic<int> height;
+        std::atomic<bool> present;
+        std::atomic<uint64_t> version{0};
+        std::atomic<Node*> parent;
+        std::atomic<Node*> left{nullptr};
+        std::atomic<Node*> right{nullptr};
+        std::mutex lock;
+        Node* retired_next = nullptr;
+
+        Node(int k, int h, bool p, Node* parent_node)
+            : key(k), height(h), present(p), parent(parent_node){};
+    };
+
+    enum Result { kRetry, kAbsent, kPresent };
+
+    static constexpr uint64_t kUnlinked = 1;
+    static constexpr uint64_t kShrinking = 2;
+    static constexpr uint64_t kIncrement = 4;
+
+    static constexpr int kUnlinkRequired = -1;
+    static constexpr int kRebalanceRequired = -2;
+    static constexpr int kNothingRequired = -3;
+
+    static constexpr size_t kReclaimThreshold = 64;
+
+    Node* holder_;
+    std::atomic<Node*> retired_{nullptr};
+    std::atomic<size_t> retired_count_{0};
+    std::atomic<size_t> size_{0};
+
+    std::mutex reclaim_lock_;
+    Node* limbo_ = nullptr;
+    uint64_t limbo_epoch_ = 0;
+
+    alignas(64) std::atomic<uint64_t> epoch_{0};
+    alignas(64) std::atomic<int> readers_[2] = {0, 0};
+
+    static int compare(int key, Node* node);
+    static int height(Node* node);
+    static Node* child(Node* node, int direction);
+    static void setChild(Node* node, int direction, Node* new_child);
+    static bool isShrinkingOrUnlinked(uint64_t version);
+    static bool isUnlinked(uint64_t version);
+    static void waitUntilNotChanging(Node* node);
+
+    Result attemptGet(int key, Node* node, int direction, uint64_t node_version, Node*& found);
+    Result attemptCeiling(int key, Node* node, int direction, uint64_t node_version,
+                          Node*& candidate);
+    Node* ceilingNode(int key);
+
+    Result update(int key, bool value);
+    Result attemptUpdate(int key, bool value, Node* parent, Node* node, uint64_t node_version);
+    Result attemptNodeUpdate(bool value, Node* parent, Node* node);
+    bool attemptUnlink_nl(Node* parent, Node* node);
+    void retire(Node* node);
+    void reclaim();
+    static void release(Node* node);
+
+    int nodeCondition(Node* node);
+    void fixHeightAndRebalance(Node* node);
+    Node* fixHeight_nl(Node* node);
+    Node* rebalance_nl(Node* parent, Node* node);
+    Node* rebalanceToRight_nl(Node* parent, Node* node, Node* left, int right_height);
+    Node* rebalanceToLeft_nl(Node* parent, Node* node, Node* right, int left_height);
+    Node* rotateRight_nl(Node* parent, Node* node, Node* left, int right_height,
+                         int left_left_height, Node* left_right, int left_right_height);
+    Node* rotateLeft_nl(Node* parent, Node* node, int left_height, Node* right,
+                        Node* right_left, int right_left_height, int right_right_height);
+    Node* rotateRightOverLeft_nl(Node* parent, Node* node, Node* left, int right_height,
+                                 int left_left_height, Node* left_right,
+                                 int left_right_left_height);
+    Node* rotateLeftOverRight_nl(Node* parent, Node* node, int left_height, Node* right,
+                                 Node* right_left, int right_right_height,
+                                 int right_left_right_height);
+
+    static void clear(Node* node);
+};
+
+ConcurrentAVLTree::ConcurrentAVLTree() {
+    holder_ = new Node(INT_MIN, 1, false, nullptr);
+}
+
+ConcurrentAVLTree::~ConcurrentAVLTree() {
+    clear(holder_->right.load());
+    delete holder_;
+
+    release(retired_.load());
+    release(limbo_);
+}
+
+ConcurrentAVLTree::Guard::Guard(ConcurrentAVLTree& tree) : tree_(tree), epoch_(tree.epoch_.load()) {
+    while (true) {
+        tree_.readers_[epoch_ & 1].fetch_add(1);
+        uint64_t again = tree_.epoch_.load();
+        if (again == epoch_) {
+            break;
+        }
+        tree_.readers_[epoch_ & 1].fetch_sub(1, std::memory_order_release);
+        epoch_ = again;
+    }
+}
+
+ConcurrentAVLTree::Guard::~Guard() {
+    tree_.readers_[epoch_ & 1].fetch_sub(1, std::memory_order_release);
+}
+
+void ConcurrentAVLTree::release(Node* node) {
+    while (node) {
+        Node* next = node->retired_next;
+        delete node;
+        node = next;
+    }
+}
+
+void ConcurrentAVLTree::clear(Node* node) {
+    if (node) {
+        clear(node->left.load());
+        clear(node->right.load());
+        delete node;
+    }
+}
+
+bool ConcurrentAVLTree::insert(int value) {
+    Result result;
+    {
+        Guard guard(*this);
+        result = update(value, true);
+    }
+    reclaim();
+
+    if (result == kPresent) {
+        return false;
+    }
+    size_.fetch_add(1);
+    return true;
+}
+
+bool ConcurrentAVLTree::erase(int value) {
+    Result result;
+    {
+        Guard guard(*this);
+        result = update(value, false);
+    }
+    reclaim();
+
+    if (result == kAbsent) {
+        return false;
+    }
+    size_.fetch_sub(1);
+    return true;
+}
+
+bool ConcurrentAVLTree::empty() {
+    return size_.load() == 0;
+}
+
+int ConcurrentAVLTree::getSize() {
+    return size_.load();
+}
+
+int ConcurrentAVLTree::compare(int key, Node* node) {
+    if (key < node->key) {
+        return -1;
+    }
+    return key > node->key ? 1 : 0;
+}
+
+int ConcurrentAVLTree::height(Node* node) {
+    return node ? node->height.load() : 0;
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::child(Node* node, int direction) {
+    return direction < 0 ? node->left.load() : node->right.load();
+}
+
+void ConcurrentAVLTree::setChild(Node* node, int direction, Node* new_child) {
+    if (direction < 0) {
+        node->left.store(new_child);
+    } else {
+        node->right.store(new_child);
+    }
+}
+
+bool ConcurrentAVLTree::isShrinkingOrUnlinked(uint64_t version) {
+    return (version & (kShrinking | kUnlinked)) != 0;
+}
+
+bool ConcurrentAVLTree::isUnlinked(uint64_t version) {
+    return (version & kUnlinked) != 0;
+}
+
+void ConcurrentAVLTree::waitUntilNotChanging(Node* node) {
+    while (node->version.load() & kShrinking) {
+        std::this_thread::yield();
+    }
+}
+
+const int* ConcurrentAVLTree::find(int value) {
+    Guard guard(*this);
+    while (true) {
+        Node* root = holder_->right.load();
+        if (root == nullptr) {
+            return nullptr;
+        }
+
+        int direction = compare(value, root);
+        if (direction == 0) {
+            return root->present.load() ? &root->key : nullptr;
+        }
+
+        uint64_t root_version = root->version.load();
+        if (isShrinkingOrUnlinked(root_version)) {
+            waitUntilNotChanging(root);
+        } else if (root == holder_->right.load()) {
+            Node* found = nullptr;
+            Result result = attemptGet(value, root, direction, root_version, found);
+            if (result != kRetry) {
+                return result == kPresent ? &found->key : nullptr;
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptGet(int key, Node* node, int direction,
+                                                        uint64_t node_version, Node*& found) {
+    while (true) {
+        Node* next = child(node, direction);
+        if (next == nullptr) {
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+            return kAbsent;
+        }
+
+        int next_direction = compare(key, next);
+        if (next_direction == 0) {
+            found = next;
+            return next->present.load() ? kPresent : kAbsent;
+        }
+
+        uint64_t next_version = next->version.load();
+        if (isShrinkingOrUnlinked(next_version)) {
+            waitUntilNotChanging(next);
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+        } else if (next != child(node, direction)) {
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+        } else {
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+            Result result = attemptGet(key, next, next_direction, next_version, found);
+            if (result != kRetry) {
+                return result;
+            }
+        }
+    }
+}
+
+const int* ConcurrentAVLTree::lowerBound(int value) {
+    Guard guard(*this);
+    while (true) {
+        Node* candidate = ceilingNode(value);
+        if (candidate == nullptr) {
+            return nullptr;
+        }
+        if (candidate->present.load()) {
+            return &candidate->key;
+        }
+        if (candidate->key == INT_MAX) {
+            return nullptr;
+        }
+        value = candidate->key + 1;
+    }
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::ceilingNode(int key) {
+    while (true) {
+        Node* root = holder_->right.load();
+        if (root == nullptr) {
+            return nullptr;
+        }
+
+        int direction = compare(key, root);
+        if (direction == 0) {
+            return root;
+        }
+
+        uint64_t root_version = root->version.load();
+        if (isShrinkingOrUnlinked(root_version)) {
+            waitUntilNotChanging(root);
+        } else if (root == holder_->right.load()) {
+            Node* candidate = direction < 0 ? root : nullptr;
+            if (attemptCeiling(key, root, direction, root_version, candidate) != kRetry) {
+                return candidate;
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptCeiling(int key, Node* node, int direction,
+                                                            uint64_t node_version,
+                                                            Node*& candidate) {
+    while (true) {
+        Node* next = child(node, direction);
+        if (next == nullptr) {
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+            return kAbsent;
+        }
+
+        int next_direction = compare(key, next);
+        if (next_direction == 0) {
+            candidate = next;
+            return kPresent;
+        }
+
+        uint64_t next_version = next->version.load();
+        if (isShrinkingOrUnlinked(next_version)) {
+            waitUntilNotChanging(next);
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+        } else if (next != child(node, direction)) {
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+        } else {
+            if (node->version.load() != node_version) {
+                return kRetry;
+            }
+            Node* saved = candidate;
+            if (next_direction < 0) {
+                candidate = next;
+            }
+            Result result = attemptCeiling(key, next, next_direction, next_version, candidate);
+            if (result != kRetry) {
+                return result;
+            }
+            candidate = saved;
+        }
+    }
+}
+
+ConcurrentAVLTree::Result ConcurrentAVLTree::update(int key, bool value) {
+    while (true) {
+        Node* root = holder_->right.load();
+        if (root == nullptr) {
+            if (!value) {
+                return kAbsent;
+            }
+
+            std::lock_guard<std::mutex> holder_lock(holder_->lock);
+            if (holder_->right.load() == nullptr) {
+                holder_->right.store(new Node(key, 1, true, holder_));
+                holder_->height.store(2);
+                return kAbsent;
+            }
+            continue;
+        }
+
+        uint64_t root_version = root->version.load();
+        if (isShrinkingOrUnlinked(root_version)) {
+            waitUntilNotChanging(root);
+        } else if (root == holder_->right.load()) {
+            Result result = attemptUpdate(key, value, holder_, root, root_version);
+            if (result != kRetry) {
+                return result;
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptUpdate(int key, bool value, Node* parent,
+                                                           Node* node, uint64_t node_version) {
+    int direction = compare(key, node);
+    if (direction == 0) {
+        return attemptNodeUpdate(value, parent, node);
+    }
+
+    while (true) {
+        Node* next = child(node, direction);
+        if (node->version.load() != node_version) {
+            return kRetry;
+        }
+
+        if (next == nullptr) {
+            if (!value) {
+                return kAbsent;
+            }
+
+            Node* damaged = nullptr;
+            bool inserted = false;
+            {
+                std::lock_guard<std::mutex> node_lock(node->lock);
+                if (node->version.load() != node_version) {
+                    return kRetry;
+                }
+                if (child(node, direction) == nullptr) {
+                    setChild(node, direction, new Node(key, 1, true, node));
+                    inserted = true;
+                    damaged = fixHeight_nl(node);
+                }
+            }
+            if (inserted) {
+                fixHeightAndRebalance(damaged);
+                return kAbsent;
+            }
+        } else {
+            uint64_t next_version = next->version.load();
+            if (isShrinkingOrUnlinked(next_version)) {
+                waitUntilNotChanging(next);
+            } else if (next == child(node, direction)) {
+                if (node->version.load() != node_version) {
+                    return kRetry;
+                }
+                Result result = attemptUpdate(key, value, node, next, next_version);
+                if (result != kRetry) {
+                    return result;
+                }
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptNodeUpdate(bool value, Node* parent,
+                                                               Node* node) {
+    if (!value && !node->present.load()) {
+        return kAbsent;
+    }
+
+    if (!value && (node->left.load() == nullptr || node->right.load() == nullptr)) {
+        Node* damaged;
+        {
+            std::lock_guard<std::mutex> parent_lock(parent->lock);
+            if (isUnlinked(parent->version.load()) || node->parent.load() != parent) {
+                return kRetry;
+            }
+
+            {
+                std::lock_guard<std::mutex> node_lock(node->lock);
+                if (!node->present.load()) {
+                    return kAbsent;
+                }
+                if (!attemptUnlink_nl(parent, node)) {
+                    return kRetry;
+                }
+            }
+            damaged = fixHeight_nl(parent);
+        }
+        fixHeightAndRebalance(damaged);
+        return kPresent;
+    }
+
+    std::lock_guard<std::mutex> node_lock(node->lock);
+    if (isUnlinked(node->version.load())) {
+        return kRetry;
+    }
+
+    Result previous = node->present.load() ? kPresent : kAbsent;
+    if (!value && (node->left.load() == nullptr || node->right.load() == nullptr)) {
+        return kRetry;
+    }
+    node->present.store(value);
+    return previous;
+}
+
+bool ConcurrentAVLTree::attemptUnlink_nl(Node* parent, Node* node) {
+    Node* parent_left = parent->left.load();
+    Node* parent_right = parent->right.load();
+    if (parent_left != node && parent_right != node) {
+        return false;
+    }
+
+    Node* left = node->left.load();
+    Node* right = node->right.load();
+    if (left != nullptr && right != nullptr) {
+        return false;
+    }
+
+    Node* splice = left ? left : right;
+    if (parent_left == node) {
+        parent->left.store(splice);
+    } else {
+        parent->right.store(splice);
+    }
+    if (splice) {
+        splice->parent.store(parent);
+    }
+
+    node->version.store(kUnlinked);
+    node->present.store(false);
+    retire(node);
+    return true;
+}
+
+void ConcurrentAVLTree::retire(Node* node) {
+    retired_count_.fetch_add(1, std::memory_order_relaxed);
+
+    Node* head = retired_.load();
+    do {
+        node->retired_next = head;
+    } while (!retired_.compare_exchange_weak(head, node));
+}
+
+// Never waits: the parked batch is freed only once every Guard from the epoch it
+// was parked in has gone, otherwise a later call tries again.
+void ConcurrentAVLTree::reclaim() {
+    if (retired_count_.load(std::memory_order_relaxed) < kReclaimThreshold) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(reclaim_lock_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    if (limbo_) {
+        if (readers_[limbo_epoch_ & 1].load() != 0) {
+            return;
+        }
+        release(limbo_);
+        limbo_ = nullptr;
+    }
+
+    limbo_ = retired_.exchange(nullptr);
+    if (limbo_ == nullptr) {
+        return;
+    }
+
+    size_t parked = 0;
+    for (Node* node = limbo_; node; node = node->retired_next) {
+        ++parked;
+    }
+    retired_count_.fetch_sub(parked, std::memory_order_relaxed);
+    limbo_epoch_ = epoch_.fetch_add(1);
+}
+
+int ConcurrentAVLTree::nodeCondition(Node* node) {
+    Node* left = node->left.load();
+    Node* right = node->right.load();
+    if ((left == nullptr || right == nullptr) && !node->present.load()) {
+        return kUnlinkRequired;
+    }
+
+    int node_height = node->height.load();
+    int left_height = height(left);
+    int right_height = height(right);
+    int new_height = std::max(left_height, right_height) + 1;
+    int balance = left_height - right_height;
+
+    if (balance < -1 || balance > 1) {
+        return kRebalanceRequired;
+    }
+    return node_height != new_height ? new_height : kNothingRequired;
+}
+
+void ConcurrentAVLTree::fixHeightAndRebalance(Node* node) {
+    while (node && node->parent.load()) {
+        int condition = nodeCondition(node);
+        if (condition == kNothingRequired || isUnlinked(node->version.load())) {
+            return;
+        }
+
+        if (condition != kUnlinkRequired && condition != kRebalanceRequired) {
+            std::lock_guard<std::mutex> node_lock(node->lock);
+            node = fixHeight_nl(node);
+        } else {
+            Node* parent = node->parent.load();
+            std::lock_guard<std::mutex> parent_lock(parent->lock);
+            if (!isUnlinked(parent->version.load()) && node->parent.load() == parent) {
+                std::lock_guard<std::mutex> node_lock(node->lock);
+                node = rebalance_nl(parent, node);
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::fixHeight_nl(Node* node) {
+    int condition = nodeCondition(node);
+    switch (condition) {
+        case kRebalanceRequired:
+        case kUnlinkRequired:
+            return node;
+        case kNothingRequired:
+            return nullptr;
+        default:
+            node->height.store(condition);
+            return node->parent.load();
+    }
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rebalance_nl(Node* parent, Node* node) {
+    Node* left = node->left.load();
+    Node* right = node->right.load();
+    if ((left == nullptr || right == nullptr) && !node->present.load()) {
+        if (attemptUnlink_nl(parent, node)) {
+            return fixHeight_nl(parent);
+        }
+        return node;
+    }
+
+    int node_height = node->height.load();
+    int left_height = height(left);
+    int right_height = height(right);
+    int new_height = std::max(left_height, right_height) + 1;
+    int balance = left_height - right_height;
+
+    if (balance > 1) {
+        return rebalanceToRight_nl(parent, node, left, right_height);
+    }
+    if (balance < -1) {
+        return rebalanceToLeft_nl(parent, node, right, left_height);
+    }
+    if (new_height != node_height) {
+        node->height.store(new_height);
+        return fixHeight_nl(parent);
+    }
+    return nullptr;
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rebalanceToRight_nl(Node* parent, Node* node,
+                                                                Node* left, int right_height) {
+    std::lock_guard<std::mutex> left_lock(left->lock);
+    if (left->height.load() - right_height <= 1) {
+        return node;
+    }
+
+    Node* left_right = left->right.load();
+    int left_left_height = height(left->left.load());
+    int left_right_height = height(left_right);
+    if (left_left_height >= left_right_height) {
+        return rotateRight_nl(parent, node, left, right_height, left_left_height, left_right,
+                              left_right_height);
+    }
+
+    {
+        std::lock_guard<std::mutex> left_right_lock(left_right->lock);
+        left_right_height = left_right->height.load();
+        if (left_left_height >= left_right_height) {
+            return rotateRight_nl(parent, node, left, right_height, left_left_height, left_right,
+                                  left_right_height);
+        }
+
+        int left_right_left_height = height(left_right->left.load());
+        int balance = left_left_height - left_right_left_height;
+        if (balance >= -1 && balance <= 1 &&
+            !((left_left_height == 0 || left_right_left_height == 0) && !left->present.load())) {
+            return rotateRightOverLeft_nl(parent, node, left, right_height, left_left_height,
+                                          left_right, left_right_left_height);
+        }
+    }
+
+    return rebalanceToLeft_nl(node, left, left_right, left_left_height);
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rebalanceToLeft_nl(Node* parent, Node* node,
+                                                               Node* right, int left_height) {
+    std::lock_guard<std::mutex> right_lock(right->lock);
+    if (left_height - right->height.load() >= -1) {
+        return node;
+    }
+
+    Node* right_left = right->left.load();
+    int right_left_height = height(right_left);
+    int right_right_height = height(right->right.load());
+    if (right_right_height >= right_left_height) {
+        return rotateLeft_nl(parent, node, left_height, right, right_left, right_left_height,
+                             right_right_height);
+    }
+
+    {
+        std::lock_guard<std::mutex> right_left_lock(right_left->lock);
+        right_left_height = right_left->height.load();
+        if (right_right_height >= right_left_height) {
+            return rotateLeft_nl(parent, node, left_height, right, right_left, right_left_height,
+                                 right_right_height);
+        }
+
+        int right_left_right_height = height(right_left->right.load());
+        int balance = right_right_height - right_left_right_height;
+        if (balance >= -1 && balance <= 1 &&
+            !((right_right_height == 0 || right_left_right_height == 0) &&
+              !right->present.load())) {
+            return rotateLeftOverRight_nl(parent, node, left_height, right, right_left,
+                                          right_right_height, right_left_right_height);
+        }
+    }
+
+    return rebalanceToRight_nl(node, right, right_left, right_right_height);
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rotateRight_nl(Node* parent, Node* node, Node* left,
+                                                           int right_height,
+                                                           int left_left_height,
+                                                           Node* left_right,
+                                                           int left_right_height) {
+    uint64_t node_version = node->version.load();
+    Node* parent_left = parent->left.load();
+
+    node->version.store(node_version | kShrinking);
+
+    node->left.store(left_right);
+    if (left_right) {
+        left_right->parent.store(node);
+    }
+
+    left->right.store(node);
+    node->parent.store(left);
+
+    if (parent_left == node) {
+        parent->left.store(left);
+    } else {
+        parent->right.store(left);
+    }
+    left->parent.store(parent);
+
+    int new_node_height = std::max(left_right_height, right_height) + 1;
+    node->height.store(new_node_height);
+    left->height.store(std::max(left_left_height, new_node_height) + 1);
+
+    node->version.store(node_version + kIncrement);
+
+    int node_balance = left_right_height - right_height;
+    if (node_balance < -1 || node_balance > 1) {
+        return node;
+    }
+    if ((left_right == nullptr || right_height == 0) && !node->present.load()) {
+        return node;
+    }
+
+    int left_balance = left_left_height - new_node_height;
+    if (left_balance < -1 || left_balance > 1) {
+        return left;
+    }
+    if (left_left_height == 0 && !left->present.load()) {
+        return left;
+    }
+
+    return fixHeight_nl(parent);
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rotateLeft_nl(Node* parent, Node* node,
+                                                          int left_height, Node* right,
+                                                          Node* right_left,
+                                                          int right_left_height,
+                                                          int right_right_height) {
+    uint64_t node_version = node->version.load();
+    Node* parent_left = parent->left.load();
+
+    node->version.store(node_version | kShrinking);
+
+    node->right.store(right_left);
+    if (right_left) {
+        right_left->parent.store(node);
+    }
+
+    right->left.store(node);
+    node->parent.store(right);
+
+    if (parent_left == node) {
+        parent->left.store(right);
+    } else {
+        parent->right.store(right);
+    }
+    right->parent.store(parent);
+
+    int new_node_height = std::max(left_height, right_left_height) + 1;
+    node->height.store(new_node_height);
+    right->height.store(std::max(new_node_height, right_right_height) + 1);
+
+    node->version.store(node_version + kIncrement);
+
+    int node_balance = right_left_height - left_height;
+    if (node_balance < -1 || node_balance > 1) {
+        return node;
+    }
+    if ((right_left == nullptr || left_height == 0) && !node->present.load()) {
+        return node;
+    }
+
+    int right_balance = right_right_height - new_node_height;
+    if (right_balance < -1 || right_balance > 1) {
+        return right;
+    }
+    if (right_right_height == 0 && !right->present.load()) {
+        return right;
+    }
+
+    return fixHeight_nl(parent);
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rotateRightOverLeft_nl(
+    Node* parent, Node* node, Node* left, int right_height, int left_left_height,
+    Node* left_right, int left_right_left_height) {
+    uint64_t node_version = node->version.load();
+    uint64_t left_version = left->version.load();
+
+    Node* parent_left = parent->left.load();
+    Node* left_right_left = left_right->left.load();
+    Node* left_right_right = left_right->right.load();
+    int left_right_right_height = height(left_right_right);
+
+    node->version.store(node_version | kShrinking);
+    left->version.store(left_version | kShrinking);
+
+    node->left.store(left_right_right);
+    if (left_right_right) {
+        left_right_right->parent.store(node);
+    }
+
+    left->right.store(left_right_left);
+    if (left_right_left) {
+        left_right_left->parent.store(left);
+    }
+
+    left_right->left.store(left);
+    left->parent.store(left_right);
+    left_right->right.store(node);
+    node->parent.store(left_right);
+
+    if (parent_left == node) {
+        parent->left.store(left_right);
+    } else {
+        parent->right.store(left_right);
+    }
+    left_right->parent.store(parent);
+
+    int new_node_height = std::max(left_right_right_height, right_height) + 1;
+    node->height.store(new_node_height);
+    int new_left_height = std::max(left_left_height, left_right_left_height) + 1;
+    left->height.store(new_left_height);
+    left_right->height.store(std::max(new_left_height, new_node_height) + 1);
+
+    node->version.store(node_version + kIncrement);
+    left->version.store(left_version + kIncrement);
+
+    int node_balance = left_right_right_height - right_height;
+    if (node_balance < -1 || node_balance > 1) {
+        return node;
+    }
+    if ((left_right_right == nullptr || right_height == 0) && !node->present.load()) {
+        return node;
+    }
+
+    int left_right_balance = new_left_height - new_node_height;
+    if (left_right_balance < -1 || left_right_balance > 1) {
+        return left_right;
+    }
+
+    return fixHeight_nl(parent);
+}
+
+ConcurrentAVLTree::Node* ConcurrentAVLTree::rotateLeftOverRight_nl(
+    Node* parent, Node* node, int left_height, Node* right, Node* right_left,
+    int right_right_height, int right_left_right_height) {
+    uint64_t node_version = node->version.load();
+    uint64_t right_version = right->version.load();
+
+    Node* parent_left = parent->left.load();
+    Node* right_left_left = right_left->left.load();
+    Node* right_left_right = right_left->right.load();
+    int right_left_left_height = height(right_left_left);
+
+    node->version.store(node_version | kShrinking);
+    right->version.store(right_version | kShrinking);
+
+    node->right.store(right_left_left);
+    if (right_left_left) {
+        right_left_left->parent.store(node);
+    }
+
+    right->left.store(right_left_right);
+    if (right_left_right) {
+        right_left_right->parent.store(right);
+    }
+
+    right_left->right.store(right);
+    right->parent.store(right_left);
+    right_left->left.store(node);
+    node->parent.store(right_left);
+
+    if (parent_left == node) {
+        parent->left.store(right_left);
+    } else {
+        parent->right.store(right_left);
+    }
+    right_left->parent.store(parent);
+
+    int new_node_height = std::max(left_height, right_left_left_height) + 1;
+    node->height.store(new_node_height);
+    int new_right_height = std::max(right_left_right_height, right_right_height) + 1;
+    right->height.store(new_right_height);
+    right_left->height.store(std::max(new_node_height, new_right_height) + 1);
+
+    node->version.store(node_version + kIncrement);
+    right->version.store(right_version + kIncrement);
+
+    int node_balance = right_left_left_height - left_height;
+    if (node_balance < -1 || node_balance > 1) {
+        return node;
+    }
+    if ((right_left_left == nullptr || left_height == 0) && !node->present.load()) {
+        return node;
+    }
+
+    int right_left_balance = new_right_height - new_node_height;
+    if (right_left_balance < -1 || right_left_balance > 1) {
+        return right_left;
+    }
+
+    return fixHeight_nl(parent);
+}
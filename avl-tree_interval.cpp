@@ -0,0 +1,435 @@
+#include <cstdio>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+struct IntervalNode {
+    IntervalNode* parent;
+    IntervalNode* left;
+    IntervalNode* right;
+
+    int start;
+    int end;
+    int height;
+    int max_end;
+
+    IntervalNode(int x, int y) {
+        start = x;
+        end = y;
+        height = 1;
+        max_end = y;
+        left = right = parent = nullptr;
+    }
+};
+
+class IntervalAVLTree {
+public:
+    IntervalAVLTree();
+
+    IntervalAVLTree(const IntervalAVLTree&) = delete;
+    IntervalAVLTree& operator=(const IntervalAVLTree&) = delete;
+
+    int getHeight();
+
+    void insert(int start, int end);
+
+    void erase(int start, int end);
+
+    bool find(int start, int end);
+
+    std::vector<std::pair<int, int>> overlapping(int lo, int hi);
+
+    template <typename Visitor>
+    void forEachOverlapping(int lo, int hi, Visitor visitor);
+
+    bool empty();
+
+    int getSize();
+
+    ~IntervalAVLTree();
+
+private:
+    IntervalNode* empty_node_ = nullptr;
+    size_t size_ = 0;
+
+    IntervalNode* root_ = nullptr;
+
+    static bool isLess(IntervalNode* first, IntervalNode* second);
+
+    void setEmptyChildren(IntervalNode* node);
+
+    void checkBalance(IntervalNode* node);
+    void updateNode(IntervalNode* node);
+
+    IntervalNode* leftTurn(IntervalNode* left_node, IntervalNode* right_node);
+    IntervalNode* smallLeftTurn(IntervalNode* left_node, IntervalNode* right_node);
+    IntervalNode* bigLeftTurn(IntervalNode* left_node, IntervalNode* right_node);
+
+    IntervalNode* rightTurn(IntervalNode* left_node, IntervalNode* right_node);
+    IntervalNode* smallRightTurn(IntervalNode* left_node, IntervalNode* right_node);
+    IntervalNode* bigRightTurn(IntervalNode* left_node, IntervalNode* right_node);
+
+    void clear(IntervalNode* root);
+    IntervalNode* myFind(int start, int end);
+    IntervalNode* myErase(IntervalNode* node);
+
+    template <typename Visitor>
+    void visitOverlapping(IntervalNode* node, int lo, int hi, Visitor& visitor);
+};
+
+IntervalAVLTree::IntervalAVLTree() {
+    empty_node_ = new IntervalNode(0, INT_MIN);
+    empty_node_->height = 0;
+}
+
+IntervalAVLTree::~IntervalAVLTree() {
+    clear(root_);
+    delete empty_node_;
+}
+
+bool IntervalAVLTree::isLess(IntervalNode* first, IntervalNode* second) {
+    return std::make_pair(first->start, first->end) < std::make_pair(second->start, second->end);
+}
+
+void IntervalAVLTree::setEmptyChildren(IntervalNode* node) {
+    node->left = empty_node_;
+    node->right = empty_node_;
+}
+
+void IntervalAVLTree::updateNode(IntervalNode* node) {
+    node->height = std::max(node->left->height, node->right->height) + 1;
+    node->max_end = std::max({node->end, node->left->max_end, node->right->max_end});
+}
+
+void IntervalAVLTree::clear(IntervalNode* root) {
+    if (root != nullptr && root != empty_node_) {
+        clear(root->left);
+        clear(root->right);
+        delete root;
+    }
+}
+
+int IntervalAVLTree::getHeight() {
+    if (root_ == nullptr) {
+        return 0;
+    }
+    return root_->height;
+}
+
+bool IntervalAVLTree::empty() {
+    return size_ == 0;
+}
+
+int IntervalAVLTree::getSize() {
+    return size_;
+}
+
+void IntervalAVLTree::insert(int start, int end) {
+    if (start > end) {
+        throw std::runtime_error("Wrong Value!");
+    }
+
+    IntervalNode* new_node = new IntervalNode(start, end);
+    setEmptyChildren(new_node);
+
+    if (root_ == nullptr) {
+        root_ = new_node;
+        size_ = 1;
+        return;
+    }
+
+    IntervalNode* current = root_;
+    while (true) {
+        if (isLess(new_node, current)) {
+            if (current->left == empty_node_) {
+                current->left = new_node;
+                break;
+            }
+            current = current->left;
+        } else if (isLess(current, new_node)) {
+            if (current->right == empty_node_) {
+                current->right = new_node;
+                break;
+            }
+            current = current->right;
+        } else {
+            delete new_node;
+            return;
+        }
+    }
+
+    new_node->parent = current;
+    checkBalance(current);
+    ++size_;
+}
+
+void IntervalAVLTree::checkBalance(IntervalNode* node) {
+    if (node->right->height - node->left->height > 1) {
+        node = leftTurn(node, node->right);
+    } else if (node->left->height - node->right->height > 1) {
+        node = rightTurn(node->left, node);
+    }
+
+    updateNode(node);
+
+    if (node->parent != nullptr) {
+        checkBalance(node->parent);
+    }
+}
+
+IntervalNode* IntervalAVLTree::leftTurn(IntervalNode* left_node, IntervalNode* right_node) {
+    if (right_node->left->height > right_node->right->height) {
+        return bigLeftTurn(left_node, right_node);
+    } else {
+        return smallLeftTurn(left_node, right_node);
+    }
+}
+
+IntervalNode* IntervalAVLTree::smallLeftTurn(IntervalNode* left_node, IntervalNode* right_node) {
+    if (left_node == root_) {
+        root_ = right_node;
+    }
+
+    right_node->parent = left_node->parent;
+    left_node->parent = right_node;
+    left_node->right = right_node->left;
+    right_node->left->parent = left_node;
+    right_node->left = left_node;
+
+    if (right_node->parent && isLess(right_node->parent, right_node)) {
+        right_node->parent->right = right_node;
+    } else if (right_node->parent) {
+        right_node->parent->left = right_node;
+    }
+
+    updateNode(left_node);
+    updateNode(right_node);
+
+    return right_node;
+}
+
+IntervalNode* IntervalAVLTree::bigLeftTurn(IntervalNode* left_node, IntervalNode* right_node) {
+    IntervalNode* middle_node = right_node->left;
+    middle_node->parent = left_node->parent;
+
+    if (left_node == root_) {
+        root_ = middle_node;
+    }
+
+    left_node->parent = middle_node;
+    left_node->right = middle_node->left;
+    left_node->right->parent = left_node;
+
+    right_node->parent = middle_node;
+    right_node->left = middle_node->right;
+    right_node->left->parent = right_node;
+
+    middle_node->left = left_node;
+    middle_node->right = right_node;
+
+    if (middle_node->parent && isLess(middle_node->parent, middle_node)) {
+        middle_node->parent->right = middle_node;
+    } else if (middle_node->parent) {
+        middle_node->parent->left = middle_node;
+    }
+
+    updateNode(left_node);
+    updateNode(right_node);
+    updateNode(middle_node);
+
+    return middle_node;
+}
+
+IntervalNode* IntervalAVLTree::rightTurn(IntervalNode* left_node, IntervalNode* right_node) {
+    if (left_node->right->height > left_node->left->height) {
+        return bigRightTurn(left_node, right_node);
+    } else {
+        return smallRightTurn(left_node, right_node);
+    }
+}
+
+IntervalNode* IntervalAVLTree::smallRightTurn(IntervalNode* left_node, IntervalNode* right_node) {
+    if (right_node == root_) {
+        root_ = left_node;
+    }
+
+    left_node->parent = right_node->parent;
+    right_node->parent = left_node;
+    right_node->left = left_node->right;
+    right_node->left->parent = right_node;
+    left_node->right = right_node;
+
+    if (left_node->parent && isLess(left_node->parent, left_node)) {
+        left_node->parent->right = left_node;
+    } else if (left_node->parent) {
+        left_node->parent->left = left_node;
+    }
+
+    updateNode(right_node);
+    updateNode(left_node);
+
+    return left_node;
+}
+
+IntervalNode* IntervalAVLTree::bigRightTurn(IntervalNode* left_node, IntervalNode* right_node) {
+    IntervalNode* middle_node = left_node->right;
+    middle_node->parent = right_node->parent;
+
+    if (right_node == root_) {
+        root_ = middle_node;
+    }
+
+    right_node->parent = middle_node;
+    right_node->left = middle_node->right;
+    right_node->left->parent = right_node;
+
+    left_node->parent = middle_node;
+    left_node->right = middle_node->left;
+    left_node->right->parent = left_node;
+
+    middle_node->left = left_node;
+    middle_node->right = right_node;
+
+    if (middle_node->parent && isLess(middle_node->parent, middle_node)) {
+        middle_node->parent->right = middle_node;
+    } else if (middle_node->parent) {
+        middle_node->parent->left = middle_node;
+    }
+
+    updateNode(left_node);
+    updateNode(right_node);
+    updateNode(middle_node);
+
+    return middle_node;
+}
+
+void IntervalAVLTree::erase(int start, int end) {
+    IntervalNode* to_delete = myFind(start, end);
+    if (to_delete == nullptr) {
+        return;
+    }
+
+    IntervalNode* to_balance = myErase(to_delete);
+    if (to_balance) {
+        checkBalance(to_balance);
+    }
+    --size_;
+}
+
+IntervalNode* IntervalAVLTree::myErase(IntervalNode* node) {
+    if (node->left == empty_node_ && node->right == empty_node_) {
+        if (node->parent && node->parent->left == node) {
+            node->parent->left = empty_node_;
+        } else if (node->parent) {
+            node->parent->right = empty_node_;
+        }
+
+        if (root_ == node) {
+            root_ = nullptr;
+        }
+
+        IntervalNode* to_return = node->parent;
+        delete node;
+        return to_return;
+    } else if (node->left == empty_node_ || node->right == empty_node_) {
+        IntervalNode* child = node->left != empty_node_ ? node->left : node->right;
+        if (node->parent && node->parent->left == node) {
+            node->parent->left = child;
+        } else if (node->parent) {
+            node->parent->right = child;
+        }
+        child->parent = node->parent;
+
+        if (root_ == node) {
+            root_ = child;
+        }
+
+        delete node;
+        return child;
+    } else {
+        IntervalNode* to_replace = node->left;
+        while (to_replace->right != empty_node_) {
+            to_replace = to_replace->right;
+        }
+        IntervalNode* to_return = to_replace;
+
+        if (to_replace->parent != node) {
+            to_replace->parent->right = to_replace->left;
+            if (to_replace->left != empty_node_) {
+                to_replace->left->parent = to_replace->parent;
+            }
+            to_return = to_replace->parent;
+
+            to_replace->left = node->left;
+            node->left->parent = to_replace;
+        }
+
+        to_replace->parent = node->parent;
+        if (node->parent && node->parent->right == node) {
+            node->parent->right = to_replace;
+        } else if (node->parent) {
+            node->parent->left = to_replace;
+        }
+        to_replace->right = node->right;
+        node->right->parent = to_replace;
+
+        if (root_ == node) {
+            root_ = to_replace;
+        }
+
+        delete node;
+        return to_return;
+    }
+}
+
+bool IntervalAVLTree::find(int start, int end) {
+    return myFind(start, end) != nullptr;
+}
+
+IntervalNode* IntervalAVLTree::myFind(int start, int end) {
+    IntervalNode* current = root_;
+    while (current != nullptr && current != empty_node_) {
+        if (current->start == start && current->end == end) {
+            return current;
+        }
+        if (std::make_pair(start, end) < std::make_pair(current->start, current->end)) {
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::pair<int, int>> IntervalAVLTree::overlapping(int lo, int hi) {
+    std::vector<std::pair<int, int>> result;
+    forEachOverlapping(lo, hi, [&result](int start, int end) { result.emplace_back(start, end); });
+    return result;
+}
+
+template <typename Visitor>
+void IntervalAVLTree::forEachOverlapping(int lo, int hi, Visitor visitor) {
+    if (root_ == nullptr || lo > hi) {
+        return;
+    }
+    visitOverlapping(root_, lo, hi, visitor);
+}
+
+template <typename Visitor>
+void IntervalAVLTree::visitOverlapping(IntervalNode* node, int lo, int hi, Visitor& visitor) {
+    if (node == empty_node_ || node->max_end < lo) {
+        return;
+    }
+
+    visitOverlapping(node->left, lo, hi, visitor);
+    if (node->start > hi) {
+        return;
+    }
+
+    if (node->end >= lo) {
+        visitor(node->start, node->end);
+    }
+    visitOverlapping(node->right, lo, hi, visitor);
+}
@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Unlike std::compare_three_way this also accepts mixed pairs such as const char* and
+// std::string, whose <=> exists but which are not three_way_comparable_with each other.
+struct ThreeWayCompare {
+    using is_transparent = void;
+
+    template <typename First, typename Second>
+    auto operator()(const First& first, const Second& second) const {
+        return first <=> second;
+    }
+};
+
+template <typename Key, typename Value, typename Compare = ThreeWayCompare>
+class AVLTree {
+public:
+    using Entry = std::pair<const Key, Value>;
+
+    AVLTree() = default;
+
+    explicit AVLTree(Compare compare) : compare_(std::move(compare)) {}
+
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    AVLTree(AVLTree&& other);
+
+    AVLTree& operator=(AVLTree&& other);
+
+    ~AVLTree();
+
+    template <typename K, typename... Args>
+    std::pair<Value*, bool> emplace(K&& key, Args&&... args);
+
+    bool insert(Key key, Value value);
+
+    template <typename K>
+    bool erase(const K& key);
+
+    template <typename K>
+    Value* find(const K& key);
+
+    template <typename K>
+    Entry* lowerBound(const K& key);
+
+    template <typename Visitor>
+    void forEach(Visitor visitor);
+
+    int getHeight();
+
+    bool empty();
+
+    int getSize();
+
+    void clear();
+
+private:
+    struct Node {
+        Entry entry;
+        Node* left = nullptr;
+        Node* right = nullptr;
+        int height = 1;
+
+        template <typename K, typename... Args>
+        Node(K&& key, Args&&... args)
+            : entry(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                    std::forward_as_tuple(std::forward<Args>(args)...)) {}
+    };
+
+    static constexpr int kMaxHeight = 64;
+
+    template <typename K>
+    static constexpr bool kLookup =
+        std::is_same_v<std::decay_t<K>, Key> || requires { typename Compare::is_transparent; };
+
+    Compare compare_;
+    Node* root_ = nullptr;
+    size_t size_ = 0;
+
+    static int height(Node* node);
+    static void updateNode(Node* node);
+    static int balanceFactor(Node* node);
+    static Node* rotateLeft(Node* node);
+    static Node* rotateRight(Node* node);
+    static Node* rebalance(Node* node);
+    static void rebalancePath(Node*** path, int depth);
+
+    static void clear(Node* node);
+
+    template <typename Visitor>
+    static void symmetric(Node* node, Visitor& visitor);
+};
+
+template <typename Key, typename Value, typename Compare>
+AVLTree<Key, Value, Compare>::AVLTree(AVLTree&& other) : compare_(other.compare_) {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+}
+
+template <typename Key, typename Value, typename Compare>
+AVLTree<Key, Value, Compare>& AVLTree<Key, Value, Compare>::operator=(AVLTree&& other) {
+    std::swap(compare_, other.compare_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    return *this;
+}
+
+template <typename Key, typename Value, typename Compare>
+AVLTree<Key, Value, Compare>::~AVLTree() {
+    clear(root_);
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K, typename... Args>
+std::pair<Value*, bool> AVLTree<Key, Value, Compare>::emplace(K&& key, Args&&... args) {
+    static_assert(kLookup<K>, "Heterogeneous lookup needs a transparent comparator");
+
+    Node** path[kMaxHeight];
+    int depth = 0;
+
+    Node** link = &root_;
+    while (*link) {
+        auto order = compare_(key, (*link)->entry.first);
+        if (order == 0) {
+            return {&(*link)->entry.second, false};
+        }
+        path[depth++] = link;
+        link = order < 0 ? &(*link)->left : &(*link)->right;
+    }
+
+    *link = new Node(std::forward<K>(key), std::forward<Args>(args)...);
+    Value* inserted = &(*link)->entry.second;
+    ++size_;
+
+    rebalancePath(path, depth);
+    return {inserted, true};
+}
+
+template <typename Key, typename Value, typename Compare>
+bool AVLTree<Key, Value, Compare>::insert(Key key, Value value) {
+    return emplace(std::move(key), std::move(value)).second;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+bool AVLTree<Key, Value, Compare>::erase(const K& key) {
+    static_assert(kLookup<K>, "Heterogeneous lookup needs a transparent comparator");
+
+    Node** path[kMaxHeight];
+    int depth = 0;
+
+    Node** link = &root_;
+    while (*link) {
+        auto order = compare_(key, (*link)->entry.first);
+        if (order == 0) {
+            break;
+        }
+        path[depth++] = link;
+        link = order < 0 ? &(*link)->left : &(*link)->right;
+    }
+    if (*link == nullptr) {
+        return false;
+    }
+
+    Node* node = *link;
+    if (node->right == nullptr) {
+        *link = node->left;
+    } else {
+        int node_depth = depth;
+        path[depth++] = link;
+
+        Node** minimum_link = &node->right;
+        while ((*minimum_link)->left) {
+            path[depth++] = minimum_link;
+            minimum_link = &(*minimum_link)->left;
+        }
+
+        Node* minimum = *minimum_link;
+        *minimum_link = minimum->right;
+        minimum->left = node->left;
+        minimum->right = node->right;
+        minimum->height = node->height;
+        *link = minimum;
+
+        if (depth > node_depth + 1) {
+            path[node_depth + 1] = &minimum->right;
+        }
+    }
+
+    delete node;
+    --size_;
+
+    rebalancePath(path, depth);
+    return true;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+Value* AVLTree<Key, Value, Compare>::find(const K& key) {
+    static_assert(kLookup<K>, "Heterogeneous lookup needs a transparent comparator");
+
+    Node* current = root_;
+    while (current) {
+        auto order = compare_(key, current->entry.first);
+        if (order == 0) {
+            return &current->entry.second;
+        }
+        current = order < 0 ? current->left : current->right;
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+typename AVLTree<Key, Value, Compare>::Entry* AVLTree<Key, Value, Compare>::lowerBound(
+    const K& key) {
+    static_assert(kLookup<K>, "Heterogeneous lookup needs a transparent comparator");
+
+    Node* found = nullptr;
+    Node* current = root_;
+    while (current) {
+        auto order = compare_(key, current->entry.first);
+        if (order == 0) {
+            return &current->entry;
+        }
+        if (order < 0) {
+            found = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return found ? &found->entry : nullptr;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename Visitor>
+void AVLTree<Key, Value, Compare>::forEach(Visitor visitor) {
+    symmetric(root_, visitor);
+}
+
+template <typename Key, typename Value, typename Compare>
+int AVLTree<Key, Value, Compare>::getHeight() {
+    return height(root_);
+}
+
+template <typename Key, typename Value, typename Compare>
+bool AVLTree<Key, Value, Compare>::empty() {
+    return size_ == 0;
+}
+
+template <typename Key, typename Value, typename Compare>
+int AVLTree<Key, Value, Compare>::getSize() {
+    return size_;
+}
+
+template <typename Key, typename Value, typename Compare>
+void AVLTree<Key, Value, Compare>::clear() {
+    clear(root_);
+    root_ = nullptr;
+    size_ = 0;
+}
+
+template <typename Key, typename Value, typename Compare>
+int AVLTree<Key, Value, Compare>::height(Node* node) {
+    return node ? node->height : 0;
+}
+
+template <typename Key, typename Value, typename Compare>
+void AVLTree<Key, Value, Compare>::updateNode(Node* node) {
+    node->height = std::max(height(node->left), height(node->right)) + 1;
+}
+
+template <typename Key, typename Value, typename Compare>
+int AVLTree<Key, Value, Compare>::balanceFactor(Node* node) {
+    return height(node->right) - height(node->left);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename AVLTree<Key, Value, Compare>::Node* AVLTree<Key, Value, Compare>::rotateLeft(
+    Node* node) {
+    Node* right_node = node->right;
+    node->right = right_node->left;
+    right_node->left = node;
+
+    updateNode(node);
+    updateNode(right_node);
+
+    return right_node;
+}
+
+template <typename Key, typename Value, typename Compare>
+typename AVLTree<Key, Value, Compare>::Node* AVLTree<Key, Value, Compare>::rotateRight(
+    Node* node) {
+    Node* left_node = node->left;
+    node->left = left_node->right;
+    left_node->right = node;
+
+    updateNode(node);
+    updateNode(left_node);
+
+    return left_node;
+}
+
+template <typename Key, typename Value, typename Compare>
+typename AVLTree<Key, Value, Compare>::Node* AVLTree<Key, Value, Compare>::rebalance(
+    Node* node) {
+    updateNode(node);
+
+    int balance = balanceFactor(node);
+    if (balance > 1) {
+        if (balanceFactor(node->right) < 0) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+    if (balance < -1) {
+        if (balanceFactor(node->left) > 0) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+
+    return node;
+}
+
+template <typename Key, typename Value, typename Compare>
+void AVLTree<Key, Value, Compare>::rebalancePath(Node*** path, int depth) {
+    while (depth > 0) {
+        Node** link = path[--depth];
+        int before = (*link)->height;
+        *link = rebalance(*link);
+        if ((*link)->height == before) {
+            break;
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Compare>
+void AVLTree<Key, Value, Compare>::clear(Node* node) {
+    if (node) {
+        clear(node->left);
+        clear(node->right);
+        delete node;
+    }
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename Visitor>
+void AVLTree<Key, Value, Compare>::symmetric(Node* node, Visitor& visitor) {
+    if (node == nullptr) {
+        return;
+    }
+    symmetric(node->left, visitor);
+    visitor(node->entry.first, node->entry.second);
+    symmetric(node->right, visitor);
+}
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct PersistentNode {
+    using Pointer = std::shared_ptr<const PersistentNode>;
+
+    int value;
+    int height;
+    int size;
+    Pointer left;
+    Pointer right;
+
+    PersistentNode(int x, Pointer left_node, Pointer right_node);
+};
+
+class PersistentAVLTree {
+public:
+    using Pointer = PersistentNode::Pointer;
+
+    class Snapshot {
+    public:
+        Snapshot(){};
+        explicit Snapshot(Pointer root) : root_(std::move(root)){};
+
+        const int* find(int value) const;
+
+        const int* lowerBound(int value) const;
+
+        int* traversal() const;
+
+        int getHeight() const;
+
+        int getSize() const;
+
+        bool empty() const;
+
+    private:
+        Pointer root_;
+
+        static void symmetric(const PersistentNode* node, int* i, int* array);
+    };
+
+    PersistentAVLTree();
+
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    ~PersistentAVLTree();
+
+    Snapshot snapshot() const;
+
+    void insert(int value);
+
+    void erase(int value);
+
+    bool contains(int value) const;
+
+private:
+    struct Version {
+        Pointer root;
+    };
+
+    static constexpr size_t kReclaimThreshold = 64;
+
+    Pointer root_;
+    std::atomic<const Version*> published_;
+    std::vector<const Version*> retired_;
+
+    alignas(64) std::atomic<uint64_t> epoch_{0};
+    alignas(64) mutable std::atomic<int> readers_[2] = {0, 0};
+
+    void publish(Pointer root);
+    void reclaim();
+
+    static int height(const Pointer& node);
+    static int size(const Pointer& node);
+    static Pointer balance(int value, const Pointer& left, const Pointer& right);
+    static Pointer insertAt(const Pointer& node, int value);
+    static Pointer eraseAt(const Pointer& node, int value);
+    static Pointer eraseMinimum(const Pointer& node);
+};
+
+PersistentNode::PersistentNode(int x, Pointer left_node, Pointer right_node)
+    : value(x), left(std::move(left_node)), right(std::move(right_node)) {
+    int left_height = left ? left->height : 0;
+    int right_height = right ? right->height : 0;
+    height = std::max(left_height, right_height) + 1;
+    size = (left ? left->size : 0) + (right ? right->size : 0) + 1;
+}
+
+const int* PersistentAVLTree::Snapshot::find(int value) const {
+    const PersistentNode* current = root_.get();
+    while (current && current->value != value) {
+        current = value < current->value ? current->left.get() : current->right.get();
+    }
+    return current ? &current->value : nullptr;
+}
+
+const int* PersistentAVLTree::Snapshot::lowerBound(int value) const {
+    const int* found = nullptr;
+    const PersistentNode* current = root_.get();
+    while (current) {
+        if (current->value >= value) {
+            found = &current->value;
+            current = current->left.get();
+        } else {
+            current = current->right.get();
+        }
+    }
+    return found;
+}
+
+int* PersistentAVLTree::Snapshot::traversal() const {
+    int* array = new int[getSize()];
+    int i = 0;
+
+    symmetric(root_.get(), &i, array);
+
+    return array;
+}
+
+void PersistentAVLTree::Snapshot::symmetric(const PersistentNode* node, int* i, int* array) {
+    if (node == nullptr) {
+        return;
+    }
+    symmetric(node->left.get(), i, array);
+    array[*i] = node->value;
+    ++*i;
+    symmetric(node->right.get(), i, array);
+}
+
+int PersistentAVLTree::Snapshot::getHeight() const {
+    return height(root_);
+}
+
+int PersistentAVLTree::Snapshot::getSize() const {
+    return size(root_);
+}
+
+bool PersistentAVLTree::Snapshot::empty() const {
+    return root_ == nullptr;
+}
+
+PersistentAVLTree::PersistentAVLTree() : published_(new Version{nullptr}) {
+}
+
+PersistentAVLTree::~PersistentAVLTree() {
+    for (const Version* version : retired_) {
+        delete version;
+    }
+    delete published_.load(std::memory_order_relaxed);
+}
+
+PersistentAVLTree::Snapshot PersistentAVLTree::snapshot() const {
+    uint64_t epoch = epoch_.load();
+    while (true) {
+        readers_[epoch & 1].fetch_add(1);
+        uint64_t again = epoch_.load();
+        if (again == epoch) {
+            break;
+        }
+        readers_[epoch & 1].fetch_sub(1, std::memory_order_release);
+        epoch = again;
+    }
+
+    Snapshot snapshot(published_.load()->root);
+    readers_[epoch & 1].fetch_sub(1, std::memory_order_release);
+    return snapshot;
+}
+
+bool PersistentAVLTree::contains(int value) const {
+    return snapshot().find(value) != nullptr;
+}
+
+void PersistentAVLTree::insert(int value) {
+    Pointer root = insertAt(root_, value);
+    if (root != root_) {
+        publish(std::move(root));
+    }
+}
+
+void PersistentAVLTree::erase(int value) {
+    Pointer root = eraseAt(root_, value);
+    if (root != root_) {
+        publish(std::move(root));
+    }
+}
+
+void PersistentAVLTree::publish(Pointer root) {
+    root_ = std::move(root);
+    retired_.push_back(published_.exchange(new Version{root_}));
+
+    if (retired_.size() >= kReclaimThreshold) {
+        reclaim();
+    }
+}
+
+void PersistentAVLTree::reclaim() {
+    uint64_t epoch = epoch_.fetch_add(1);
+    while (readers_[epoch & 1].load() != 0) {
+        std::this_thread::yield();
+    }
+
+    for (const Version* version : retired_) {
+        delete version;
+    }
+    retired_.clear();
+}
+
+int PersistentAVLTree::height(const Pointer& node) {
+    return node ? node->height : 0;
+}
+
+int PersistentAVLTree::size(const Pointer& node) {
+    return node ? node->size : 0;
+}
+
+PersistentAVLTree::Pointer PersistentAVLTree::balance(int value, const Pointer& left,
+                                                      const Pointer& right) {
+    if (height(right) > height(left) + 1) {
+        if (height(right->left) > height(right->right)) {
+            const Pointer& middle = right->left;
+            return std::make_shared<const PersistentNode>(
+                middle->value, std::make_shared<const PersistentNode>(value, left, middle->left),
+                std::make_shared<const PersistentNode>(right->value, middle->right,
+                                                       right->right));
+        }
+        return std::make_shared<const PersistentNode>(
+            right->value, std::make_shared<const PersistentNode>(value, left, right->left),
+            right->right);
+    }
+
+    if (height(left) > height(right) + 1) {
+        if (height(left->right) > height(left->left)) {
+            const Pointer& middle = left->right;
+            return std::make_shared<const PersistentNode>(
+                middle->value,
+                std::make_shared<const PersistentNode>(left->value, left->left, middle->left),
+                std::make_shared<const PersistentNode>(value, middle->right, right));
+        }
+        return std::make_shared<const PersistentNode>(
+            left->value, left->left,
+            std::make_shared<const PersistentNode>(value, left->right, right));
+    }
+
+    return std::make_shared<const PersistentNode>(value, left, right);
+}
+
+PersistentAVLTree::Pointer PersistentAVLTree::insertAt(const Pointer& node, int value) {
+    if (node == nullptr) {
+        return std::make_shared<const PersistentNode>(value, nullptr, nullptr);
+    }
+
+    if (value < node->value) {
+        Pointer left = insertAt(node->left, value);
+        return left == node->left ? node : balance(node->value, left, node->right);
+    }
+    if (value > node->value) {
+        Pointer right = insertAt(node->right, value);
+        return right == node->right ? node : balance(node->value, node->left, right);
+    }
+    return node;
+}
+
+PersistentAVLTree::Pointer PersistentAVLTree::eraseAt(const Pointer& node, int value) {
+    if (node == nullptr) {
+        return node;
+    }
+
+    if (value < node->value) {
+        Pointer left = eraseAt(node->left, value);
+        return left == node->left ? node : balance(node->value, left, node->right);
+    }
+    if (value > node->value) {
+        Pointer right = eraseAt(node->right, value);
+        return right == node->right ? node : balance(node->value, node->left, right);
+    }
+
+    if (node->left == nullptr) {
+        return node->right;
+    }
+    if (node->right == nullptr) {
+        return node->left;
+    }
+
+    const PersistentNode* minimum = node->right.get();
+    while (minimum->left) {
+        minimum = minimum->left.get();
+    }
+    return balance(minimum->value, node->left, eraseMinimum(node->right));
+}
+
+PersistentAVLTree::Pointer PersistentAVLTree::eraseMinimum(const Pointer& node) {
+    if (node->left == nullptr) {
+        return node->right;
+    }
+    return balance(node->value, eraseMinimum(node->left), node->right);
+}
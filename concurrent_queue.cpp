@@ -0,0 +1,398 @@
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+class HazardDomain {
+public:
+    static constexpr size_t kHazardsPerRecord = 2;
+
+    struct Record {
+        std::atomic<bool> active{false};
+        std::atomic<void*> hazards[kHazardsPerRecord];
+        std::vector<std::pair<void*, void (*)(void*)>> retired;
+        Record* next = nullptr;
+
+        Record() {
+            for (std::atomic<void*>& hazard : hazards) {
+                hazard.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    HazardDomain(){};
+
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+
+    ~HazardDomain();
+
+    Record* acquire();
+
+    void release(Record* record);
+
+    void retire(Record* record, void* pointer, void (*deleter)(void*));
+
+private:
+    static constexpr size_t kScanThreshold = 64;
+
+    std::atomic<Record*> records_{nullptr};
+    std::atomic<size_t> record_count_{0};
+
+    void scan(Record* record);
+};
+
+HazardDomain::~HazardDomain() {
+    Record* current = records_.load(std::memory_order_relaxed);
+    while (current) {
+        for (auto& [pointer, deleter] : current->retired) {
+            deleter(pointer);
+        }
+
+        Record* next = current->next;
+        delete current;
+        current = next;
+    }
+}
+
+HazardDomain::Record* HazardDomain::acquire() {
+    for (Record* current = records_.load(std::memory_order_acquire); current;
+         current = current->next) {
+        if (current->active.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        bool expected = false;
+        if (current->active.compare_exchange_strong(expected, true, std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+            return current;
+        }
+    }
+
+    Record* record = new Record;
+    record->active.store(true, std::memory_order_relaxed);
+
+    Record* head = records_.load(std::memory_order_relaxed);
+    do {
+        record->next = head;
+    } while (!records_.compare_exchange_weak(head, record, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    record_count_.fetch_add(1, std::memory_order_relaxed);
+
+    return record;
+}
+
+void HazardDomain::release(Record* record) {
+    for (std::atomic<void*>& hazard : record->hazards) {
+        hazard.store(nullptr, std::memory_order_release);
+    }
+    record->active.store(false, std::memory_order_release);
+}
+
+void HazardDomain::retire(Record* record, void* pointer, void (*deleter)(void*)) {
+    record->retired.emplace_back(pointer, deleter);
+
+    size_t records = record_count_.load(std::memory_order_relaxed);
+    size_t threshold = kScanThreshold + 2 * kHazardsPerRecord * records;
+    if (record->retired.size() >= threshold) {
+        scan(record);
+    }
+}
+
+void HazardDomain::scan(Record* record) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::vector<void*> protected_pointers;
+    for (Record* current = records_.load(std::memory_order_acquire); current;
+         current = current->next) {
+        for (std::atomic<void*>& hazard : current->hazards) {
+            void* pointer = hazard.load(std::memory_order_acquire);
+            if (pointer) {
+                protected_pointers.push_back(pointer);
+            }
+        }
+    }
+
+    std::vector<std::pair<void*, void (*)(void*)>> still_retired;
+    for (auto& [pointer, deleter] : record->retired) {
+        bool in_use = false;
+        for (void* hazard : protected_pointers) {
+            if (hazard == pointer) {
+                in_use = true;
+                break;
+            }
+        }
+
+        if (in_use) {
+            still_retired.emplace_back(pointer, deleter);
+        } else {
+            deleter(pointer);
+        }
+    }
+    record->retired.swap(still_retired);
+}
+
+class ConcurrentQueue {
+public:
+    ConcurrentQueue();
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    ~ConcurrentQueue();
+
+    void pushBack(int value);
+
+    int pop();
+
+    std::optional<int> tryPop();
+
+    size_t size() const;
+
+private:
+    struct Node {
+        int data = 0;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<Node*> tail_;
+    alignas(64) std::atomic<size_t> size_{0};
+
+    HazardDomain hazards_;
+
+    static void deleteNode(void* node);
+    static Node* protect(std::atomic<void*>& hazard, const std::atomic<Node*>& source);
+};
+
+ConcurrentQueue::ConcurrentQueue() {
+    Node* dummy = new Node;
+    head_.store(dummy, std::memory_order_relaxed);
+    tail_.store(dummy, std::memory_order_relaxed);
+}
+
+ConcurrentQueue::~ConcurrentQueue() {
+    Node* current = head_.load(std::memory_order_relaxed);
+    while (current) {
+        Node* next = current->next.load(std::memory_order_relaxed);
+        delete current;
+        current = next;
+    }
+}
+
+void ConcurrentQueue::deleteNode(void* node) {
+    delete static_cast<Node*>(node);
+}
+
+ConcurrentQueue::Node* ConcurrentQueue::protect(std::atomic<void*>& hazard,
+                                                const std::atomic<Node*>& source) {
+    Node* node = source.load(std::memory_order_relaxed);
+    while (true) {
+        hazard.store(node, std::memory_order_seq_cst);
+        Node* again = source.load(std::memory_order_seq_cst);
+        if (again == node) {
+            return node;
+        }
+        node = again;
+    }
+}
+
+void ConcurrentQueue::pushBack(int value) {
+    if (value > 2 * 1e9 || value < -2 * 1e9) {
+        throw std::runtime_error("Wrong Value!");
+    }
+
+    Node* new_node = new Node;
+    new_node->data = value;
+    size_.fetch_add(1, std::memory_order_relaxed);
+
+    HazardDomain::Record* record = hazards_.acquire();
+    while (true) {
+        Node* tail = protect(record->hazards[0], tail_);
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail != tail_.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        if (next != nullptr) {
+            tail_.compare_exchange_weak(tail, next, std::memory_order_release,
+                                        std::memory_order_relaxed);
+            continue;
+        }
+
+        Node* expected = nullptr;
+        if (tail->next.compare_exchange_weak(expected, new_node, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+            tail_.compare_exchange_strong(tail, new_node, std::memory_order_release,
+                                          std::memory_order_relaxed);
+            break;
+        }
+    }
+    hazards_.release(record);
+}
+
+std::optional<int> ConcurrentQueue::tryPop() {
+    HazardDomain::Record* record = hazards_.acquire();
+
+    std::optional<int> value;
+    while (true) {
+        Node* head = protect(record->hazards[0], head_);
+        Node* tail = tail_.load(std::memory_order_acquire);
+        Node* next = protect(record->hazards[1], head->next);
+        if (head != head_.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        if (next == nullptr) {
+            break;
+        }
+
+        if (head == tail) {
+            tail_.compare_exchange_weak(tail, next, std::memory_order_release,
+                                        std::memory_order_relaxed);
+            continue;
+        }
+
+        int data = next->data;
+        if (head_.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+            value = data;
+            record->hazards[0].store(nullptr, std::memory_order_release);
+            hazards_.retire(record, head, &ConcurrentQueue::deleteNode);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    hazards_.release(record);
+    return value;
+}
+
+int ConcurrentQueue::pop() {
+    std::optional<int> value = tryPop();
+    if (!value) {
+        throw std::runtime_error("Can not pop such element!");
+    }
+    return *value;
+}
+
+size_t ConcurrentQueue::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+class BoundedConcurrentQueue {
+public:
+    explicit BoundedConcurrentQueue(size_t capacity);
+
+    BoundedConcurrentQueue(const BoundedConcurrentQueue&) = delete;
+    BoundedConcurrentQueue& operator=(const BoundedConcurrentQueue&) = delete;
+
+    ~BoundedConcurrentQueue();
+
+    bool tryPushBack(int value);
+
+    std::optional<int> tryPop();
+
+    void pushBack(int value);
+
+    int pop();
+
+    size_t capacity() const;
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        int data;
+    };
+
+    Cell* cells_;
+    size_t mask_;
+
+    alignas(64) std::atomic<size_t> enqueue_position_{0};
+    alignas(64) std::atomic<size_t> dequeue_position_{0};
+};
+
+BoundedConcurrentQueue::BoundedConcurrentQueue(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+
+    cells_ = new Cell[rounded];
+    mask_ = rounded - 1;
+    for (size_t i = 0; i < rounded; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+BoundedConcurrentQueue::~BoundedConcurrentQueue() {
+    delete[] cells_;
+}
+
+size_t BoundedConcurrentQueue::capacity() const {
+    return mask_ + 1;
+}
+
+bool BoundedConcurrentQueue::tryPushBack(int value) {
+    if (value > 2 * 1e9 || value < -2 * 1e9) {
+        throw std::runtime_error("Wrong Value!");
+    }
+
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (difference == 0) {
+            if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                        std::memory_order_relaxed)) {
+                cell.data = value;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::optional<int> BoundedConcurrentQueue::tryPop() {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference =
+            static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+        if (difference == 0) {
+            if (dequeue_position_.compare_exchange_weak(position, position + 1,
+                                                        std::memory_order_relaxed)) {
+                int value = cell.data;
+                cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                return value;
+            }
+        } else if (difference < 0) {
+            return std::nullopt;
+        } else {
+            position = dequeue_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void BoundedConcurrentQueue::pushBack(int value) {
+    if (!tryPushBack(value)) {
+        throw std::runtime_error("Queue is full!");
+    }
+}
+
+int BoundedConcurrentQueue::pop() {
+    std::optional<int> value = tryPop();
+    if (!value) {
+        throw std::runtime_error("Can not pop such element!");
+    }
+    return *value;
+}
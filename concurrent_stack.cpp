@@ -0,0 +1,237 @@
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+class ConcurrentStack {
+public:
+    ConcurrentStack(){};
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    ~ConcurrentStack();
+
+    void push(int value);
+
+    int pop();
+
+    int back() const;
+
+    size_t size() const;
+
+private:
+    struct Node {
+        std::atomic<int> value{0};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    struct alignas(64) EliminationSlot {
+        std::atomic<uint64_t> state{0};
+    };
+
+    static_assert(sizeof(void*) == 8, "tagged pointers need a 64-bit address space");
+
+    // The top 16 bits of a user-space pointer are unused on x86-64 and AArch64,
+    // so they hold a modification counter that defeats ABA on the list heads.
+    static constexpr int kTagShift = 48;
+    static constexpr uint64_t kPointerMask = (uint64_t(1) << kTagShift) - 1;
+
+    static constexpr uint64_t kSlotOffer = uint64_t(1) << 32;
+    static constexpr uint64_t kSlotTaken = uint64_t(2) << 32;
+    static constexpr size_t kEliminationSize = 16;
+    static constexpr int kEliminationSpins = 128;
+
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> free_{0};
+    alignas(64) std::atomic<size_t> size_{0};
+
+    EliminationSlot elimination_[kEliminationSize];
+
+    static Node* getPointer(uint64_t tagged);
+    static uint64_t makeTagged(Node* node, uint64_t previous);
+
+    static bool tryPushNode(std::atomic<uint64_t>& list, Node* node);
+    static Node* tryPopNode(std::atomic<uint64_t>& list, bool* is_empty);
+
+    static void pushNode(std::atomic<uint64_t>& list, Node* node);
+    static Node* popNode(std::atomic<uint64_t>& list);
+    static void deleteList(std::atomic<uint64_t>& list);
+
+    EliminationSlot& randomSlot();
+    bool eliminatePush(int value);
+    bool eliminatePop(int* value);
+};
+
+ConcurrentStack::~ConcurrentStack() {
+    deleteList(head_);
+    deleteList(free_);
+}
+
+ConcurrentStack::Node* ConcurrentStack::getPointer(uint64_t tagged) {
+    return reinterpret_cast<Node*>(tagged & kPointerMask);
+}
+
+uint64_t ConcurrentStack::makeTagged(Node* node, uint64_t previous) {
+    uint64_t tag = (previous >> kTagShift) + 1;
+    return reinterpret_cast<uint64_t>(node) | (tag << kTagShift);
+}
+
+bool ConcurrentStack::tryPushNode(std::atomic<uint64_t>& list, Node* node) {
+    uint64_t old_head = list.load(std::memory_order_relaxed);
+    node->next.store(getPointer(old_head), std::memory_order_relaxed);
+
+    return list.compare_exchange_strong(old_head, makeTagged(node, old_head),
+                                        std::memory_order_release, std::memory_order_relaxed);
+}
+
+ConcurrentStack::Node* ConcurrentStack::tryPopNode(std::atomic<uint64_t>& list, bool* is_empty) {
+    uint64_t old_head = list.load(std::memory_order_acquire);
+    Node* node = getPointer(old_head);
+    if (node == nullptr) {
+        *is_empty = true;
+        return nullptr;
+    }
+    *is_empty = false;
+
+    Node* next = node->next.load(std::memory_order_relaxed);
+    if (list.compare_exchange_strong(old_head, makeTagged(next, old_head),
+                                     std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return node;
+    }
+    return nullptr;
+}
+
+void ConcurrentStack::pushNode(std::atomic<uint64_t>& list, Node* node) {
+    while (!tryPushNode(list, node)) {
+    }
+}
+
+ConcurrentStack::Node* ConcurrentStack::popNode(std::atomic<uint64_t>& list) {
+    bool is_empty = false;
+    while (true) {
+        Node* node = tryPopNode(list, &is_empty);
+        if (node != nullptr || is_empty) {
+            return node;
+        }
+    }
+}
+
+void ConcurrentStack::deleteList(std::atomic<uint64_t>& list) {
+    Node* current = getPointer(list.load(std::memory_order_relaxed));
+    while (current != nullptr) {
+        Node* next = current->next.load(std::memory_order_relaxed);
+        delete current;
+        current = next;
+    }
+    list.store(0, std::memory_order_relaxed);
+}
+
+ConcurrentStack::EliminationSlot& ConcurrentStack::randomSlot() {
+    thread_local uint32_t seed = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&seed)) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return elimination_[seed % kEliminationSize];
+}
+
+bool ConcurrentStack::eliminatePush(int value) {
+    std::atomic<uint64_t>& state = randomSlot().state;
+
+    uint64_t offer = kSlotOffer | static_cast<uint32_t>(value);
+    uint64_t expected = 0;
+    if (!state.compare_exchange_strong(expected, offer, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+        return false;
+    }
+
+    for (int i = 0; i < kEliminationSpins; ++i) {
+        if (state.load(std::memory_order_acquire) == kSlotTaken) {
+            state.store(0, std::memory_order_release);
+            return true;
+        }
+    }
+
+    expected = offer;
+    if (state.compare_exchange_strong(expected, 0, std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        return false;
+    }
+
+    state.store(0, std::memory_order_release);
+    return true;
+}
+
+bool ConcurrentStack::eliminatePop(int* value) {
+    std::atomic<uint64_t>& state = randomSlot().state;
+
+    uint64_t offer = state.load(std::memory_order_acquire);
+    if ((offer & ~uint64_t(UINT32_MAX)) != kSlotOffer) {
+        return false;
+    }
+
+    if (!state.compare_exchange_strong(offer, kSlotTaken, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+        return false;
+    }
+
+    *value = static_cast<int>(static_cast<uint32_t>(offer));
+    return true;
+}
+
+void ConcurrentStack::push(int value) {
+    Node* node = popNode(free_);
+    if (node == nullptr) {
+        node = new Node;
+    }
+    node->value.store(value, std::memory_order_relaxed);
+    size_.fetch_add(1, std::memory_order_relaxed);
+
+    while (!tryPushNode(head_, node)) {
+        if (eliminatePush(value)) {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            pushNode(free_, node);
+            return;
+        }
+    }
+}
+
+int ConcurrentStack::pop() {
+    bool is_empty = false;
+    while (true) {
+        Node* node = tryPopNode(head_, &is_empty);
+        if (node != nullptr) {
+            int value = node->value.load(std::memory_order_relaxed);
+            pushNode(free_, node);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return value;
+        }
+        if (is_empty) {
+            throw "error";
+        }
+
+        int value = 0;
+        if (eliminatePop(&value)) {
+            return value;
+        }
+    }
+}
+
+int ConcurrentStack::back() const {
+    while (true) {
+        uint64_t old_head = head_.load(std::memory_order_acquire);
+        Node* node = getPointer(old_head);
+        if (node == nullptr) {
+            throw "error";
+        }
+
+        int value = node->value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (head_.load(std::memory_order_relaxed) == old_head) {
+            return value;
+        }
+    }
+}
+
+size_t ConcurrentStack::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,231 @@
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+
+class Deque {
+public:
+    Deque();
+
+    Deque(const int* values, size_t size);
+
+    Deque(const Deque& other);
+
+    ~Deque();
+
+    Deque& operator=(const Deque& other);
+
+    size_t size() const;
+
+    size_t capacity() const;
+
+    bool empty() const;
+
+    void pushBack(int value);
+
+    void pushFront(int value);
+
+    int pop();
+
+    int popBack();
+
+    int front() const;
+
+    int back() const;
+
+    int& operator[](size_t pos);
+
+    const int& operator[](size_t pos) const;
+
+    void clear();
+
+private:
+    static constexpr size_t kMinCapacity = 16;
+
+    int* arr_;
+    size_t capacity_;
+    size_t mask_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    static void checkValue(int value);
+
+    void reallocate(size_t n_capacity);
+    void shrinkIfSparse();
+    void swap(Deque& other);
+};
+
+Deque::Deque() : capacity_(kMinCapacity), mask_(kMinCapacity - 1) {
+    arr_ = new int[capacity_];
+}
+
+Deque::Deque(const int* values, size_t size) : Deque() {
+    for (size_t i = 0; i < size; ++i) {
+        if (values[i] >= 2 * 1e9 || values[i] <= -2 * 1e9) {
+            throw std::runtime_error("Wrong Value!");
+        }
+    }
+
+    size_t n_capacity = kMinCapacity;
+    while (n_capacity < size) {
+        n_capacity *= 2;
+    }
+    reallocate(n_capacity);
+
+    if (size != 0) {
+        memcpy(arr_, values, size * sizeof(int));
+    }
+    size_ = size;
+}
+
+Deque::Deque(const Deque& other) : Deque() {
+    reallocate(other.capacity_);
+    for (size_t i = 0; i < other.size_; ++i) {
+        arr_[i] = other[i];
+    }
+    size_ = other.size_;
+}
+
+Deque::~Deque() {
+    delete[] arr_;
+}
+
+Deque& Deque::operator=(const Deque& other) {
+    Deque copy = other;
+    swap(copy);
+    return *this;
+}
+
+size_t Deque::size() const {
+    return size_;
+}
+
+size_t Deque::capacity() const {
+    return capacity_;
+}
+
+bool Deque::empty() const {
+    return size_ == 0;
+}
+
+void Deque::pushBack(int value) {
+    checkValue(value);
+
+    if (size_ == capacity_) {
+        reallocate(capacity_ * 2);
+    }
+
+    arr_[(head_ + size_) & mask_] = value;
+    ++size_;
+}
+
+void Deque::pushFront(int value) {
+    checkValue(value);
+
+    if (size_ == capacity_) {
+        reallocate(capacity_ * 2);
+    }
+
+    head_ = (head_ - 1) & mask_;
+    arr_[head_] = value;
+    ++size_;
+}
+
+int Deque::pop() {
+    if (size_ == 0) {
+        throw std::runtime_error("Can not pop such element!");
+    }
+
+    int value_to_return = arr_[head_];
+    head_ = (head_ + 1) & mask_;
+    --size_;
+
+    shrinkIfSparse();
+    return value_to_return;
+}
+
+int Deque::popBack() {
+    if (size_ == 0) {
+        throw std::runtime_error("Can not pop such element!");
+    }
+
+    --size_;
+    int value_to_return = arr_[(head_ + size_) & mask_];
+
+    shrinkIfSparse();
+    return value_to_return;
+}
+
+int Deque::front() const {
+    if (size_ == 0) {
+        throw std::runtime_error("Empty Deque!");
+    }
+
+    return arr_[head_];
+}
+
+int Deque::back() const {
+    if (size_ == 0) {
+        throw std::runtime_error("Empty Deque!");
+    }
+
+    return arr_[(head_ + size_ - 1) & mask_];
+}
+
+int& Deque::operator[](size_t pos) {
+    if (pos >= size_) {
+        throw std::runtime_error("Wrong Position!");
+    }
+    return arr_[(head_ + pos) & mask_];
+}
+
+const int& Deque::operator[](size_t pos) const {
+    if (pos >= size_) {
+        throw std::runtime_error("Wrong Position!");
+    }
+    return arr_[(head_ + pos) & mask_];
+}
+
+void Deque::clear() {
+    head_ = 0;
+    size_ = 0;
+    shrinkIfSparse();
+}
+
+void Deque::checkValue(int value) {
+    if (value > 2 * 1e9 || value < -2 * 1e9) {
+        throw std::runtime_error("Wrong Value!");
+    }
+}
+
+void Deque::reallocate(size_t n_capacity) {
+    int* new_arr = new int[n_capacity];
+
+    size_t first_part = std::min(size_, capacity_ - head_);
+    memcpy(new_arr, arr_ + head_, first_part * sizeof(int));
+    memcpy(new_arr + first_part, arr_, (size_ - first_part) * sizeof(int));
+
+    delete[] arr_;
+    arr_ = new_arr;
+    capacity_ = n_capacity;
+    mask_ = n_capacity - 1;
+    head_ = 0;
+}
+
+void Deque::shrinkIfSparse() {
+    if (capacity_ > kMinCapacity && size_ * 4 <= capacity_) {
+        size_t n_capacity = capacity_;
+        while (n_capacity > kMinCapacity && size_ * 4 <= n_capacity) {
+            n_capacity /= 2;
+        }
+        reallocate(n_capacity);
+    }
+}
+
+void Deque::swap(Deque& other) {
+    std::swap(arr_, other.arr_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(mask_, other.mask_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+}
@@ -0,0 +1,285 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+struct IndexNode {
+    int data = 0;
+    uint32_t next = 0;
+    uint32_t previous = 0;
+};
+
+class IndexList {
+public:
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    IndexList(){};
+
+    IndexList(int* values, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            if (values[i] >= 2 * 1e9 || values[i] <= -2 * 1e9) {
+                throw std::runtime_error("Wrong Value!");
+            }
+        }
+
+        nodes_.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            nodes_[i].data = values[i];
+            nodes_[i].next = static_cast<uint32_t>(i + 1 == size ? 0 : i + 1);
+            nodes_[i].previous = static_cast<uint32_t>(i == 0 ? size - 1 : i - 1);
+        }
+
+        if (size != 0) {
+            head_ = 0;
+            tail_ = static_cast<uint32_t>(size - 1);
+        }
+        size_ = static_cast<uint32_t>(size);
+    }
+
+    int size() {
+        return static_cast<int>(size_);
+    }
+
+    void pushBack(int value) {
+        checkValue(value);
+
+        uint32_t new_node = allocate(value);
+        if (head_ == kNil) {
+            linkFirst(new_node);
+        } else {
+            linkAfter(tail_, new_node);
+            tail_ = new_node;
+        }
+    }
+
+    void pushFront(int value) {
+        checkValue(value);
+
+        uint32_t new_node = allocate(value);
+        if (head_ == kNil) {
+            linkFirst(new_node);
+        } else {
+            linkAfter(tail_, new_node);
+            head_ = new_node;
+        }
+    }
+
+    int pop() {
+        if (head_ == kNil) {
+            throw std::runtime_error("Can not pop such element!");
+        }
+
+        return unlink(head_);
+    }
+
+    int pop(size_t position) {
+        if (position + 1 >= size_) {
+            throw std::runtime_error("Wrong Position!");
+        }
+
+        return unlink(nodeAt(position + 1));
+    }
+
+    void push(int value, size_t position) {
+        if (position >= size_) {
+            throw std::runtime_error("Wrong Position!");
+        }
+        checkValue(value);
+
+        uint32_t current = nodeAt(position);
+        uint32_t new_node = allocate(value);
+        linkAfter(current, new_node);
+
+        if (current == tail_) {
+            tail_ = new_node;
+        }
+    }
+
+    template <typename Function>
+    void forEach(Function function) const {
+        uint32_t current = head_;
+        for (uint32_t i = 0; i < size_; ++i) {
+            function(nodes_[current].data);
+            current = nodes_[current].next;
+        }
+    }
+
+    size_t serializedSize() const {
+        return sizeof(Header) + nodes_.size() * sizeof(IndexNode);
+    }
+
+    void serialize(void* out) const {
+        Header header{head_, tail_, free_, size_, static_cast<uint32_t>(nodes_.size())};
+        memcpy(out, &header, sizeof(Header));
+        if (!nodes_.empty()) {
+            memcpy(static_cast<char*>(out) + sizeof(Header), nodes_.data(),
+                   nodes_.size() * sizeof(IndexNode));
+        }
+    }
+
+    static IndexList deserialize(const void* in, size_t bytes) {
+        Header header;
+        if (bytes < sizeof(Header)) {
+            throw std::runtime_error("Wrong Data!");
+        }
+        memcpy(&header, in, sizeof(Header));
+        if (bytes != sizeof(Header) + size_t(header.capacity) * sizeof(IndexNode)) {
+            throw std::runtime_error("Wrong Data!");
+        }
+
+        IndexList list;
+        list.head_ = header.head;
+        list.tail_ = header.tail;
+        list.free_ = header.free;
+        list.size_ = header.size;
+        list.nodes_.resize(header.capacity);
+        if (header.capacity != 0) {
+            memcpy(list.nodes_.data(), static_cast<const char*>(in) + sizeof(Header),
+                   header.capacity * sizeof(IndexNode));
+        }
+
+        if (!list.isConsistent()) {
+            throw std::runtime_error("Wrong Data!");
+        }
+        return list;
+    }
+
+private:
+    struct Header {
+        uint32_t head;
+        uint32_t tail;
+        uint32_t free;
+        uint32_t size;
+        uint32_t capacity;
+    };
+
+    std::vector<IndexNode> nodes_;
+    uint32_t head_ = kNil;
+    uint32_t tail_ = kNil;
+    uint32_t free_ = kNil;
+    uint32_t size_ = 0;
+
+    // Every slot must be either on the circular chain from head_ or on the free
+    // chain, exactly once, with all links inside nodes_.
+    bool isConsistent() const {
+        size_t capacity = nodes_.size();
+        if (capacity >= kNil || size_ > capacity) {
+            return false;
+        }
+        if ((size_ == 0) != (head_ == kNil) || (size_ == 0) != (tail_ == kNil)) {
+            return false;
+        }
+
+        std::vector<bool> seen(capacity, false);
+
+        uint32_t current = head_;
+        for (uint32_t i = 0; i < size_; ++i) {
+            if (current >= capacity || seen[current]) {
+                return false;
+            }
+            seen[current] = true;
+
+            uint32_t next = nodes_[current].next;
+            if (next >= capacity || nodes_[next].previous != current) {
+                return false;
+            }
+            if ((i + 1 == size_) != (current == tail_)) {
+                return false;
+            }
+            current = next;
+        }
+        if (size_ != 0 && current != head_) {
+            return false;
+        }
+
+        size_t free_count = 0;
+        for (current = free_; current != kNil; current = nodes_[current].next) {
+            if (current >= capacity || seen[current]) {
+                return false;
+            }
+            seen[current] = true;
+            ++free_count;
+        }
+
+        return size_ + free_count == capacity;
+    }
+
+    static void checkValue(int value) {
+        if (value > 2 * 1e9 || value < -2 * 1e9) {
+            throw std::runtime_error("Wrong Value!");
+        }
+    }
+
+    uint32_t allocate(int value) {
+        uint32_t index = free_;
+        if (index != kNil) {
+            free_ = nodes_[index].next;
+        } else {
+            if (nodes_.size() >= kNil) {
+                throw std::runtime_error("List is full!");
+            }
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+
+        nodes_[index].data = value;
+        ++size_;
+        return index;
+    }
+
+    void linkFirst(uint32_t node) {
+        nodes_[node].next = node;
+        nodes_[node].previous = node;
+        head_ = tail_ = node;
+    }
+
+    void linkAfter(uint32_t current, uint32_t node) {
+        uint32_t next = nodes_[current].next;
+
+        nodes_[node].previous = current;
+        nodes_[node].next = next;
+        nodes_[next].previous = node;
+        nodes_[current].next = node;
+    }
+
+    int unlink(uint32_t node) {
+        int value_to_return = nodes_[node].data;
+
+        if (head_ == tail_) {
+            head_ = tail_ = kNil;
+        } else {
+            uint32_t previous = nodes_[node].previous;
+            uint32_t next = nodes_[node].next;
+            nodes_[previous].next = next;
+            nodes_[next].previous = previous;
+
+            if (node == head_) {
+                head_ = next;
+            }
+            if (node == tail_) {
+                tail_ = previous;
+            }
+        }
+
+        nodes_[node].next = free_;
+        free_ = node;
+        --size_;
+
+        return value_to_return;
+    }
+
+    uint32_t nodeAt(size_t position) const {
+        uint32_t current = head_;
+        if (position <= size_ / 2) {
+            for (size_t i = 0; i < position; ++i) {
+                current = nodes_[current].next;
+            }
+        } else {
+            current = tail_;
+            for (size_t i = size_ - 1; i > position; --i) {
+                current = nodes_[current].previous;
+            }
+        }
+        return current;
+    }
+};
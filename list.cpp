@@ -1,4 +1,12 @@
 #include <iostream>
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <functional>
+#include <optional>
+#include <limits>
 
 class Node {
 public:
@@ -15,31 +23,324 @@ public:
     ~Node(){};
 };
 
+class NodePool {
+public:
+    NodePool(){};
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        release();
+    }
+
+    Node* allocate(int data) {
+        Node* node = free_;
+        if (node) {
+            free_ = free_->next;
+        } else {
+            if (cursor_ == block_end_) {
+                addBlock();
+            }
+            node = cursor_++;
+        }
+
+        return new (node) Node(data);
+    }
+
+    Node* allocateBlock(const int* values, size_t count) {
+        if (!store_) {
+            store_ = std::make_shared<BlockStore>();
+        }
+
+        Node* block = static_cast<Node*>(::operator new(count * sizeof(Node)));
+        store_->blocks.push_back(block);
+
+        for (size_t i = 0; i < count; ++i) {
+            new (block + i) Node(values[i]);
+        }
+        return block;
+    }
+
+    void deallocate(Node* node) {
+        node->next = free_;
+        free_ = node;
+    }
+
+    void adopt(const NodePool& other) {
+        if (!other.store_ || other.store_ == store_) {
+            return;
+        }
+        for (const std::shared_ptr<BlockStore>& store : adopted_) {
+            if (store == other.store_) {
+                return;
+            }
+        }
+        adopted_.push_back(other.store_);
+    }
+
+    void release() {
+        store_.reset();
+        adopted_.clear();
+
+        free_ = nullptr;
+        cursor_ = block_end_ = nullptr;
+        next_block_size_ = kMinBlockSize;
+    }
+
+private:
+    static constexpr size_t kMinBlockSize = 16;
+    static constexpr size_t kMaxBlockSize = 4096;
+
+    struct BlockStore {
+        std::vector<Node*> blocks;
+
+        ~BlockStore() {
+            for (Node* block : blocks) {
+                ::operator delete(block);
+            }
+        }
+    };
+
+    std::shared_ptr<BlockStore> store_;
+    std::vector<std::shared_ptr<BlockStore>> adopted_;
+    Node* free_ = nullptr;
+    Node* cursor_ = nullptr;
+    Node* block_end_ = nullptr;
+    size_t next_block_size_ = kMinBlockSize;
+
+    void addBlock() {
+        if (!store_) {
+            store_ = std::make_shared<BlockStore>();
+        }
+
+        Node* block = static_cast<Node*>(::operator new(next_block_size_ * sizeof(Node)));
+        store_->blocks.push_back(block);
+
+        cursor_ = block;
+        block_end_ = block + next_block_size_;
+        next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+    }
+};
+
+class PositionIndex {
+public:
+    PositionIndex() {
+        header_.links.resize(kMaxLevel);
+    }
+
+    PositionIndex(const PositionIndex&) = delete;
+    PositionIndex& operator=(const PositionIndex&) = delete;
+
+    ~PositionIndex() {
+        clear();
+    }
+
+    void build(Node* head, size_t size) {
+        clear();
+
+        Tower* last[kMaxLevel];
+        size_t last_position[kMaxLevel];
+        for (size_t level = 0; level < kMaxLevel; ++level) {
+            last[level] = &header_;
+            last_position[level] = 0;
+        }
+
+        Node* current = head;
+        for (size_t position = 1; position <= size; ++position) {
+            size_t height = randomHeight();
+            if (height > 0) {
+                Tower* tower = new Tower{current, std::vector<Link>(height)};
+                for (size_t level = 0; level < height; ++level) {
+                    last[level]->links[level] = {tower, position - last_position[level]};
+                    last[level] = tower;
+                    last_position[level] = position;
+                }
+                levels_ = std::max(levels_, height);
+            }
+            current = current->next;
+        }
+    }
+
+    Node* find(size_t index, Node* head) const {
+        size_t target = index + 1;
+        size_t position = 0;
+        const Tower* current = &header_;
+
+        for (size_t level = levels_; level-- > 0;) {
+            while (current->links[level].next &&
+                   position + current->links[level].width <= target) {
+                position += current->links[level].width;
+                current = current->links[level].next;
+            }
+        }
+
+        Node* node = current == &header_ ? head : current->node;
+        size_t steps = current == &header_ ? index : target - position;
+        for (size_t i = 0; i < steps; ++i) {
+            node = node->next;
+        }
+        return node;
+    }
+
+    void insert(size_t index, Node* node) {
+        size_t target = index + 1;
+        size_t height = randomHeight();
+        Tower* tower = height > 0 ? new Tower{node, std::vector<Link>(height)} : nullptr;
+        levels_ = std::max(levels_, height);
+
+        size_t position = 0;
+        Tower* current = &header_;
+        for (size_t level = levels_; level-- > 0;) {
+            Link* link = &current->links[level];
+            while (link->next && position + link->width < target) {
+                position += link->width;
+                current = link->next;
+                link = &current->links[level];
+            }
+
+            if (level < height) {
+                if (link->next) {
+                    tower->links[level] = {link->next, position + link->width + 1 - target};
+                }
+                *link = {tower, target - position};
+            } else if (link->next) {
+                ++link->width;
+            }
+        }
+    }
+
+    void erase(size_t index) {
+        size_t target = index + 1;
+        Tower* victim = nullptr;
+
+        size_t position = 0;
+        Tower* current = &header_;
+        for (size_t level = levels_; level-- > 0;) {
+            Link* link = &current->links[level];
+            while (link->next && position + link->width < target) {
+                position += link->width;
+                current = link->next;
+                link = &current->links[level];
+            }
+
+            if (link->next && position + link->width == target) {
+                victim = link->next;
+                Link& skipped = victim->links[level];
+                *link = {skipped.next, link->width + skipped.width - 1};
+            } else if (link->next) {
+                --link->width;
+            }
+        }
+
+        delete victim;
+    }
+
+private:
+    static constexpr size_t kMaxLevel = 16;
+
+    struct Tower;
+
+    struct Link {
+        Tower* next = nullptr;
+        size_t width = 0;
+    };
+
+    struct Tower {
+        Node* node = nullptr;
+        std::vector<Link> links;
+    };
+
+    Tower header_;
+    size_t levels_ = 0;
+    uint64_t seed_ = 0x9E3779B97F4A7C15ull;
+
+    size_t randomHeight() {
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 7;
+        seed_ ^= seed_ << 17;
+
+        size_t height = 0;
+        uint64_t bits = seed_;
+        while (height < kMaxLevel && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    void clear() {
+        Tower* current = header_.links[0].next;
+        while (current) {
+            Tower* next = current->links[0].next;
+            delete current;
+            current = next;
+        }
+
+        for (Link& link : header_.links) {
+            link = Link();
+        }
+        levels_ = 0;
+    }
+};
+
 class List {
 private:
     size_t size_ = 0;
 
+    NodePool own_pool_;
+    NodePool* pool_ = &own_pool_;
+
+    PositionIndex* index_ = nullptr;
+
 public:
     List() {
         head = nullptr;
         tail = head;
     }
 
+    explicit List(NodePool* pool) {
+        pool_ = pool;
+        head = nullptr;
+        tail = head;
+    }
+
     List(int* values, size_t size) {
-        for (int i = 0; i < static_cast<int>(size); ++i) {
-            if (values[i] >= 2 * 1e9 || values[i] <= -2 * 1e9) {
-                for (int j = 0; j < i; ++j) {
-                    this->pop();
-                }
+        if (size == 0) {
+            return;
+        }
 
-                throw std::runtime_error("Wrong Value!");
-            }
+        const int limit = 2000000000;
+        int min_value = values[0];
+        int max_value = values[0];
+        for (size_t i = 1; i < size; ++i) {
+            min_value = std::min(min_value, values[i]);
+            max_value = std::max(max_value, values[i]);
+        }
+        if (max_value >= limit || min_value <= -limit) {
+            throw std::runtime_error("Wrong Value!");
+        }
 
-            this->pushBack(values[i]);
+        Node* nodes = pool_->allocateBlock(values, size);
+        for (size_t i = 0; i + 1 < size; ++i) {
+            nodes[i].next = nodes + i + 1;
+            nodes[i + 1].previous = nodes + i;
         }
+
+        head = nodes;
+        tail = nodes + size - 1;
+        head->previous = tail;
+        tail->next = head;
+        size_ = size;
     }
 
     ~List() {
+        dropPositionIndex();
+
+        if (pool_ == &own_pool_) {
+            return;
+        }
+
         while (size_ != 0) {
             this->pop();
         }
@@ -54,7 +355,7 @@ public:
             throw std::runtime_error("Wrong Value!");
         }
 
-        Node* new_node = new Node(value);
+        Node* new_node = pool_->allocate(value);
 
         if (!head) {
             head = new_node;
@@ -79,6 +380,10 @@ public:
                 tail->next = head;
             }
         }
+
+        if (index_) {
+            index_->insert(size_, new_node);
+        }
         ++size_;
     }
 
@@ -87,7 +392,7 @@ public:
             throw std::runtime_error("Wrong Value!");
         }
 
-        Node* new_node = new Node(value);
+        Node* new_node = pool_->allocate(value);
 
         if (!head) {
             head = new_node;
@@ -112,6 +417,10 @@ public:
                 tail->next = head;
             }
         }
+
+        if (index_) {
+            index_->insert(0, new_node);
+        }
         ++size_;
     }
 
@@ -122,8 +431,12 @@ public:
 
         int value_to_return = head->data;
 
+        if (index_) {
+            index_->erase(0);
+        }
+
         if (head == tail) {
-            delete head;
+            pool_->deallocate(head);
 
             head = tail = nullptr;
 
@@ -140,39 +453,78 @@ public:
 
         --size_;
 
-        delete to_delete;
+        pool_->deallocate(to_delete);
 
         return value_to_return;
     }
 
-    int pop(size_t position) {
-        if (position + 1 >= size_) {
-            throw std::runtime_error("Wrong Position!");
+    int popBack() {
+        if (!tail) {
+            throw std::runtime_error("Can not pop such element!");
         }
-        --size_;
 
-        Node* current = head;
+        int value_to_return = tail->data;
 
-        for (int i = 0; i <= static_cast<int>(position); ++i) {
-            current = current->next;
+        if (index_) {
+            index_->erase(size_ - 1);
         }
 
-        int value_to_return = current->data;
-
-        if (current->next == head) {
+        Node* to_delete = tail;
+        if (head == tail) {
+            head = tail = nullptr;
+        } else {
             tail = tail->previous;
-            tail->next = head;
             head->previous = tail;
+            tail->next = head;
+        }
 
-            delete current;
+        --size_;
 
-            return value_to_return;
+        pool_->deallocate(to_delete);
+
+        return value_to_return;
+    }
+
+    int erase(Node* node) {
+        if (node == head) {
+            return pop();
+        }
+        if (node == tail) {
+            return popBack();
         }
 
+        int value_to_return = node->data;
+
+        node->previous->next = node->next;
+        node->next->previous = node->previous;
+        --size_;
+
+        pool_->deallocate(node);
+        refreshPositionIndex();
+
+        return value_to_return;
+    }
+
+    int pop(size_t position) {
+        if (position + 1 >= size_) {
+            throw std::runtime_error("Wrong Position!");
+        }
+
+        Node* current = nodeAt(position + 1);
+        if (index_) {
+            index_->erase(position + 1);
+        }
+        --size_;
+
+        int value_to_return = current->data;
+
+        if (current == tail) {
+            tail = tail->previous;
+        }
         current->previous->next = current->next;
         current->next->previous = current->previous;
 
-        delete current;
+        pool_->deallocate(current);
 
         return value_to_return;
     }
@@ -185,45 +537,419 @@ public:
             throw std::runtime_error("Wrong Value!");
         }
 
+        Node* current = nodeAt(position);
+        Node* new_node = pool_->allocate(value);
+
+        new_node->next = current->next;
+        new_node->previous = current;
+        current->next->previous = new_node;
+        current->next = new_node;
+
+        if (current == tail) {
+            tail = new_node;
+        }
+
+        if (index_) {
+            index_->insert(position + 1, new_node);
+        }
         ++size_;
+    }
 
-        Node* current = head;
-        Node* new_node = new Node(value);
+    void splice(Node* after, List& other) {
+        if (&other == this || other.size_ == 0) {
+            return;
+        }
+        splice(after, other, other.head, other.tail, other.size_);
+    }
 
-        for (int i = 0; i < static_cast<int>(position); ++i) {
-            current = current->next;
+    void splice(Node* after, List& other, Node* first, Node* last, size_t count) {
+        if (count == 0) {
+            return;
         }
 
-        if (head == tail) {
-            tail = new_node;
-            tail->previous = head;
-            tail->next = head;
-            head->previous = tail;
-            head->next = tail;
+        if (count == other.size_) {
+            other.head = other.tail = nullptr;
+        } else {
+            first->previous->next = last->next;
+            last->next->previous = first->previous;
+
+            if (first == other.head) {
+                other.head = last->next;
+            }
+            if (last == other.tail) {
+                other.tail = first->previous;
+            }
+        }
+        other.size_ -= count;
+
+        if (!head) {
+            head = first;
+            tail = last;
+        } else if (!after) {
+            first->previous = tail;
+            tail->next = first;
+            head->previous = last;
+            last->next = head;
+            head = first;
+        } else {
+            Node* next = after->next;
+            after->next = first;
+            first->previous = after;
+            last->next = next;
+            next->previous = last;
+
+            if (after == tail) {
+                tail = last;
+            }
+        }
+        head->previous = tail;
+        tail->next = head;
+        size_ += count;
+
+        if (pool_ != other.pool_) {
+            pool_->adopt(*other.pool_);
+        }
+        refreshPositionIndex();
+        other.refreshPositionIndex();
+    }
+
+    void merge(List& other) {
+        if (&other == this || other.size_ == 0) {
             return;
         }
 
-        if (current->previous == tail) {
-            new_node->next = head->next;
-            new_node->previous = head;
-            head->next = new_node;
+        size_t total = size_ + other.size_;
+        Node* merged = mergeChains(openChain(), other.openChain());
+
+        other.head = other.tail = nullptr;
+        other.size_ = 0;
+        if (pool_ != other.pool_) {
+            pool_->adopt(*other.pool_);
+        }
+        other.refreshPositionIndex();
+
+        closeChain(merged, total);
+    }
+
+    void sort() {
+        if (size_ < 2) {
             return;
         }
 
-        if (current->next == head) {
-            tail->next = new_node;
-            new_node->previous = tail;
-            new_node->next = head;
-            head->previous = new_node;
-            tail = new_node;
+        Node* chain = openChain();
+        for (size_t width = 1; width < size_; width *= 2) {
+            Node* sorted = nullptr;
+            Node** sorted_end = &sorted;
+
+            while (chain) {
+                Node* left = chain;
+                Node* right = cutChain(left, width);
+                chain = cutChain(right, width);
+
+                *sorted_end = mergeChains(left, right);
+                while (*sorted_end) {
+                    sorted_end = &(*sorted_end)->next;
+                }
+            }
+            chain = sorted;
+        }
+
+        closeChain(chain, size_);
+    }
+
+    void reverse() {
+        if (size_ < 2) {
             return;
         }
 
-        new_node->next = current->next;
-        new_node->previous = current;
-        current->next = new_node;
+        Node* current = head;
+        do {
+            std::swap(current->next, current->previous);
+            current = current->previous;
+        } while (current != head);
+
+        std::swap(head, tail);
+        refreshPositionIndex();
+    }
+
+    void buildPositionIndex() {
+        if (!index_) {
+            index_ = new PositionIndex;
+        }
+        index_->build(head, size_);
+    }
+
+    void dropPositionIndex() {
+        delete index_;
+        index_ = nullptr;
     }
 
     Node* head{};
     Node* tail{};
+
+private:
+    void refreshPositionIndex() {
+        if (index_) {
+            index_->build(head, size_);
+        }
+    }
+
+    Node* openChain() {
+        if (!head) {
+            return nullptr;
+        }
+
+        Node* chain = head;
+        tail->next = nullptr;
+        head = tail = nullptr;
+        return chain;
+    }
+
+    void closeChain(Node* chain, size_t size) {
+        size_ = size;
+        head = chain;
+
+        Node* previous = nullptr;
+        for (Node* current = chain; current; current = current->next) {
+            current->previous = previous;
+            previous = current;
+        }
+        tail = previous;
+
+        if (head) {
+            head->previous = tail;
+            tail->next = head;
+        }
+        refreshPositionIndex();
+    }
+
+    static Node* cutChain(Node* chain, size_t count) {
+        for (size_t i = 1; chain && i < count; ++i) {
+            chain = chain->next;
+        }
+        if (!chain) {
+            return nullptr;
+        }
+
+        Node* rest = chain->next;
+        chain->next = nullptr;
+        return rest;
+    }
+
+    static Node* mergeChains(Node* left, Node* right) {
+        Node* merged = nullptr;
+        Node** merged_end = &merged;
+
+        while (left && right) {
+            if (right->data < left->data) {
+                *merged_end = right;
+                right = right->next;
+            } else {
+                *merged_end = left;
+                left = left->next;
+            }
+            merged_end = &(*merged_end)->next;
+        }
+        *merged_end = left ? left : right;
+
+        return merged;
+    }
+
+    Node* nodeAt(size_t position) {
+        if (index_) {
+            return index_->find(position, head);
+        }
+
+        Node* current = head;
+        if (position <= size_ / 2) {
+            for (size_t i = 0; i < position; ++i) {
+                current = current->next;
+            }
+        } else {
+            current = tail;
+            for (size_t i = size_ - 1; i > position; --i) {
+                current = current->previous;
+            }
+        }
+        return current;
+    }
+};
+
+template <typename K, typename V>
+class LRUCache {
+public:
+    explicit LRUCache(size_t max_entries, size_t max_bytes = std::numeric_limits<size_t>::max()) {
+        if (max_entries == 0) {
+            throw std::runtime_error("Wrong Capacity!");
+        }
+
+        max_entries_ = max_entries;
+        max_bytes_ = max_bytes;
+        table_.assign(16, nullptr);
+    }
+
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    V* get(const K& key) {
+        Node** cell = findCell(key);
+        if (!*cell) {
+            ++misses_;
+            return nullptr;
+        }
+
+        ++hits_;
+        Node* node = *cell;
+        if (node != order_.head) {
+            order_.splice(nullptr, order_, node, node, 1);
+        }
+        return &entries_[node->data]->value;
+    }
+
+    bool put(const K& key, V value, size_t bytes = sizeof(K) + sizeof(V)) {
+        erase(key);
+        if (bytes > max_bytes_) {
+            return false;
+        }
+
+        while (size() >= max_entries_ || bytes_ + bytes > max_bytes_) {
+            evict();
+        }
+
+        int slot;
+        if (free_slots_.empty()) {
+            slot = static_cast<int>(entries_.size());
+            entries_.emplace_back();
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        entries_[slot].emplace(Entry{key, std::move(value), bytes});
+
+        order_.pushFront(slot);
+        insertCell(key, order_.head);
+        bytes_ += bytes;
+        return true;
+    }
+
+    bool erase(const K& key) {
+        Node** cell = findCell(key);
+        if (!*cell) {
+            return false;
+        }
+
+        Node* node = *cell;
+        *cell = &tombstone_;
+        ++tombstones_;
+
+        releaseSlot(order_.erase(node));
+        return true;
+    }
+
+    size_t size() {
+        return static_cast<size_t>(order_.size());
+    }
+
+    size_t bytes() const {
+        return bytes_;
+    }
+
+    size_t hits() const {
+        return hits_;
+    }
+
+    size_t misses() const {
+        return misses_;
+    }
+
+private:
+    struct Entry {
+        K key;
+        V value;
+        size_t bytes;
+    };
+
+    static inline Node tombstone_;
+
+    List order_;
+    std::vector<std::optional<Entry>> entries_;
+    std::vector<int> free_slots_;
+
+    std::vector<Node*> table_;
+    size_t used_ = 0;
+    size_t tombstones_ = 0;
+
+    size_t max_entries_;
+    size_t max_bytes_;
+    size_t bytes_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    size_t bucket(const K& key) const {
+        return (std::hash<K>()(key) * 0x9E3779B97F4A7C15ull >> 32) & (table_.size() - 1);
+    }
+
+    Node** findCell(const K& key) {
+        size_t mask = table_.size() - 1;
+        for (size_t i = bucket(key);; i = (i + 1) & mask) {
+            Node* node = table_[i];
+            if (!node) {
+                return &table_[i];
+            }
+            if (node != &tombstone_ && entries_[node->data]->key == key) {
+                return &table_[i];
+            }
+        }
+    }
+
+    void insertCell(const K& key, Node* node) {
+        if ((used_ + tombstones_ + 1) * 2 > table_.size()) {
+            rehash();
+        }
+
+        size_t mask = table_.size() - 1;
+        size_t i = bucket(key);
+        while (table_[i] && table_[i] != &tombstone_) {
+            i = (i + 1) & mask;
+        }
+
+        if (table_[i] == &tombstone_) {
+            --tombstones_;
+        }
+        table_[i] = node;
+        ++used_;
+    }
+
+    void rehash() {
+        size_t capacity = table_.size();
+        while ((used_ + 1) * 4 > capacity) {
+            capacity *= 2;
+        }
+
+        std::vector<Node*> old_table(capacity, nullptr);
+        old_table.swap(table_);
+        used_ = 0;
+        tombstones_ = 0;
+
+        for (Node* node : old_table) {
+            if (node && node != &tombstone_) {
+                insertCell(entries_[node->data]->key, node);
+            }
+        }
+    }
+
+    void evict() {
+        Node** cell = findCell(entries_[order_.tail->data]->key);
+        *cell = &tombstone_;
+        ++tombstones_;
+
+        releaseSlot(order_.popBack());
+    }
+
+    void releaseSlot(int slot) {
+        bytes_ -= entries_[slot]->bytes;
+        entries_[slot].reset();
+        free_slots_.push_back(slot);
+        --used_;
+    }
 };
@@ -0,0 +1,230 @@
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <algorithm>
+#include <memory>
+#include <new>
+
+template <typename T = int, size_t ChunkSize = 1024>
+class ChunkedStack {
+public:
+    ChunkedStack(){};
+
+    ChunkedStack(const ChunkedStack&) = delete;
+    ChunkedStack& operator=(const ChunkedStack&) = delete;
+
+    ~ChunkedStack();
+
+    void push(const T& value);
+
+    void push(T&& value);
+
+    T pop();
+
+    const T& back() const;
+
+    std::optional<T> tryPop();
+
+    std::optional<T> tryBack() const;
+
+    void pushMany(std::span<const T> values);
+
+    size_t popMany(T* out, size_t count);
+
+    size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+private:
+    static_assert(ChunkSize > 0, "chunk must hold at least one element");
+
+    struct Chunk {
+        Chunk* previous = nullptr;
+        alignas(T) unsigned char storage[sizeof(T) * ChunkSize];
+
+        T* data() {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    Chunk* top_ = nullptr;
+    Chunk* spare_ = nullptr;
+    size_t top_size_ = 0;
+    size_t size_ = 0;
+
+    T* prepareSlot();
+    void dropEmptyChunk();
+    void releaseSlot();
+};
+
+template <typename T, size_t ChunkSize>
+ChunkedStack<T, ChunkSize>::~ChunkedStack() {
+    clear();
+    delete spare_;
+}
+
+template <typename T, size_t ChunkSize>
+T* ChunkedStack<T, ChunkSize>::prepareSlot() {
+    if (top_ == nullptr || top_size_ == ChunkSize) {
+        Chunk* chunk = spare_;
+        if (chunk != nullptr) {
+            spare_ = nullptr;
+        } else {
+            chunk = new Chunk;
+        }
+
+        chunk->previous = top_;
+        top_ = chunk;
+        top_size_ = 0;
+    }
+
+    return top_->data() + top_size_;
+}
+
+// Also undoes prepareSlot when constructing into a fresh chunk threw.
+template <typename T, size_t ChunkSize>
+void ChunkedStack<T, ChunkSize>::dropEmptyChunk() {
+    if (top_size_ != 0) {
+        return;
+    }
+
+    Chunk* unused = top_;
+    top_ = unused->previous;
+    top_size_ = top_ ? ChunkSize : 0;
+
+    delete spare_;
+    spare_ = unused;
+}
+
+template <typename T, size_t ChunkSize>
+void ChunkedStack<T, ChunkSize>::releaseSlot() {
+    std::destroy_at(top_->data() + top_size_ - 1);
+    --top_size_;
+    --size_;
+    dropEmptyChunk();
+}
+
+template <typename T, size_t ChunkSize>
+void ChunkedStack<T, ChunkSize>::push(const T& value) {
+    T* slot = prepareSlot();
+    try {
+        std::construct_at(slot, value);
+    } catch (...) {
+        dropEmptyChunk();
+        throw;
+    }
+    ++top_size_;
+    ++size_;
+}
+
+template <typename T, size_t ChunkSize>
+void ChunkedStack<T, ChunkSize>::push(T&& value) {
+    T* slot = prepareSlot();
+    try {
+        std::construct_at(slot, std::move(value));
+    } catch (...) {
+        dropEmptyChunk();
+        throw;
+    }
+    ++top_size_;
+    ++size_;
+}
+
+template <typename T, size_t ChunkSize>
+T ChunkedStack<T, ChunkSize>::pop() {
+    if (size_ == 0) {
+        throw "error";
+    }
+
+    T last_element = std::move(top_->data()[top_size_ - 1]);
+    releaseSlot();
+    return last_element;
+}
+
+template <typename T, size_t ChunkSize>
+const T& ChunkedStack<T, ChunkSize>::back() const {
+    if (size_ == 0) {
+        throw "error";
+    }
+
+    return top_->data()[top_size_ - 1];
+}
+
+template <typename T, size_t ChunkSize>
+std::optional<T> ChunkedStack<T, ChunkSize>::tryPop() {
+    if (size_ == 0) {
+        return std::nullopt;
+    }
+
+    std::optional<T> last_element(std::move(top_->data()[top_size_ - 1]));
+    releaseSlot();
+    return last_element;
+}
+
+template <typename T, size_t ChunkSize>
+std::optional<T> ChunkedStack<T, ChunkSize>::tryBack() const {
+    if (size_ == 0) {
+        return std::nullopt;
+    }
+
+    return top_->data()[top_size_ - 1];
+}
+
+template <typename T, size_t ChunkSize>
+void ChunkedStack<T, ChunkSize>::pushMany(std::span<const T> values) {
+    size_t copied = 0;
+    while (copied < values.size()) {
+        T* slot = prepareSlot();
+        size_t step = std::min(ChunkSize - top_size_, values.size() - copied);
+
+        try {
+            std::uninitialized_copy_n(values.data() + copied, step, slot);
+        } catch (...) {
+            dropEmptyChunk();
+            throw;
+        }
+        top_size_ += step;
+        size_ += step;
+        copied += step;
+    }
+}
+
+// Same ordering as Stack::popMany: out[0] is the deepest popped element.
+template <typename T, size_t ChunkSize>
+size_t ChunkedStack<T, ChunkSize>::popMany(T* out, size_t count) {
+    count = std::min(count, size_);
+
+    size_t left = count;
+    while (left > 0) {
+        size_t step = std::min(top_size_, left);
+        T* first = top_->data() + top_size_ - step;
+
+        std::move(first, first + step, out + left - step);
+        left -= step;
+
+        for (size_t i = 0; i < step; ++i) {
+            releaseSlot();
+        }
+    }
+
+    return count;
+}
+
+template <typename T, size_t ChunkSize>
+size_t ChunkedStack<T, ChunkSize>::size() const {
+    return size_;
+}
+
+template <typename T, size_t ChunkSize>
+bool ChunkedStack<T, ChunkSize>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T, size_t ChunkSize>
+void ChunkedStack<T, ChunkSize>::clear() {
+    while (size_ != 0) {
+        releaseSlot();
+    }
+}
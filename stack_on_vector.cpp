@@ -1,48 +1,271 @@
-#include <iostream>
-#include <vector>
-
-class Stack {
-public:
-    void push(int value);
-
-    int pop();
-
-    int back() const;
-
-    size_t size() const;
-
-    void clear();
-
-private:
-    std::vector<int> body_;
-};
-
-void Stack::push(int value) {
-    body_.push_back(value);
-}
-
-int Stack::pop() {
-    if (body_.empty()) {
-        throw "error";
-    }
-
-    int last_element = body_.back();
-    body_.pop_back();
-    return last_element;
-}
-
-int Stack::back() const {
-    if (body_.empty()) {
-        throw "error";
-    }
-
-    return body_.back();
-}
-
-size_t Stack::size() const {
-    return body_.size();
-}
-
-void Stack::clear() {
-    body_.clear();
-}
+#include <iostream>
+#include <vector>
+#include <optional>
+#include <span>
+#include <algorithm>
+#include <utility>
+
+template <typename T = int>
+class Stack {
+public:
+    void push(const T& value);
+
+    void push(T&& value);
+
+    T pop();
+
+    const T& back() const;
+
+    std::optional<T> tryPop();
+
+    std::optional<T> tryBack() const;
+
+    void pushMany(std::span<const T> values);
+
+    size_t popMany(T* out, size_t count);
+
+    size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+private:
+    std::vector<T> body_;
+};
+
+template <typename T>
+void Stack<T>::push(const T& value) {
+    body_.push_back(value);
+}
+
+template <typename T>
+void Stack<T>::push(T&& value) {
+    body_.push_back(std::move(value));
+}
+
+template <typename T>
+T Stack<T>::pop() {
+    if (body_.empty()) {
+        throw "error";
+    }
+
+    T last_element = std::move(body_.back());
+    body_.pop_back();
+    return last_element;
+}
+
+template <typename T>
+const T& Stack<T>::back() const {
+    if (body_.empty()) {
+        throw "error";
+    }
+
+    return body_.back();
+}
+
+template <typename T>
+std::optional<T> Stack<T>::tryPop() {
+    if (body_.empty()) {
+        return std::nullopt;
+    }
+
+    std::optional<T> last_element(std::move(body_.back()));
+    body_.pop_back();
+    return last_element;
+}
+
+template <typename T>
+std::optional<T> Stack<T>::tryBack() const {
+    if (body_.empty()) {
+        return std::nullopt;
+    }
+
+    return body_.back();
+}
+
+template <typename T>
+void Stack<T>::pushMany(std::span<const T> values) {
+    body_.insert(body_.end(), values.begin(), values.end());
+}
+
+// Moves up to count elements off the top into out, keeping their stack order:
+// out[0] is the deepest popped element, so pushMany(out, n) undoes the call.
+template <typename T>
+size_t Stack<T>::popMany(T* out, size_t count) {
+    count = std::min(count, body_.size());
+
+    auto first = body_.end() - static_cast<std::ptrdiff_t>(count);
+    std::move(first, body_.end(), out);
+    body_.erase(first, body_.end());
+
+    return count;
+}
+
+template <typename T>
+size_t Stack<T>::size() const {
+    return body_.size();
+}
+
+template <typename T>
+bool Stack<T>::empty() const {
+    return body_.empty();
+}
+
+template <typename T>
+void Stack<T>::clear() {
+    body_.clear();
+}
+
+struct AggregateMin {
+    template <typename T>
+    T operator()(const T& a, const T& b) const {
+        return std::min(a, b);
+    }
+};
+
+struct AggregateMax {
+    template <typename T>
+    T operator()(const T& a, const T& b) const {
+        return std::max(a, b);
+    }
+};
+
+// Combine must be associative and commutative (min, max, sum, gcd, ...).
+template <typename T = int, typename Combine = AggregateMin>
+class AggregateStack {
+public:
+    void push(const T& value);
+
+    T pop();
+
+    const T& back() const;
+
+    const T& aggregate() const;
+
+    size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+private:
+    Stack<std::pair<T, T>> body_;
+    Combine combine_;
+};
+
+template <typename T, typename Combine>
+void AggregateStack<T, Combine>::push(const T& value) {
+    if (body_.empty()) {
+        body_.push({value, value});
+    } else {
+        body_.push({value, combine_(body_.back().second, value)});
+    }
+}
+
+template <typename T, typename Combine>
+T AggregateStack<T, Combine>::pop() {
+    return body_.pop().first;
+}
+
+template <typename T, typename Combine>
+const T& AggregateStack<T, Combine>::back() const {
+    return body_.back().first;
+}
+
+template <typename T, typename Combine>
+const T& AggregateStack<T, Combine>::aggregate() const {
+    return body_.back().second;
+}
+
+template <typename T, typename Combine>
+size_t AggregateStack<T, Combine>::size() const {
+    return body_.size();
+}
+
+template <typename T, typename Combine>
+bool AggregateStack<T, Combine>::empty() const {
+    return body_.empty();
+}
+
+template <typename T, typename Combine>
+void AggregateStack<T, Combine>::clear() {
+    body_.clear();
+}
+
+template <typename T = int, typename Combine = AggregateMin>
+class SlidingWindowQueue {
+public:
+    explicit SlidingWindowQueue(size_t window);
+
+    void push(const T& value);
+
+    T pop();
+
+    T aggregate() const;
+
+    size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+private:
+    size_t window_;
+
+    AggregateStack<T, Combine> in_;
+    AggregateStack<T, Combine> out_;
+    Combine combine_;
+};
+
+template <typename T, typename Combine>
+SlidingWindowQueue<T, Combine>::SlidingWindowQueue(size_t window) : window_(window) {
+    if (window_ == 0) {
+        throw "error";
+    }
+}
+
+template <typename T, typename Combine>
+void SlidingWindowQueue<T, Combine>::push(const T& value) {
+    if (size() == window_) {
+        pop();
+    }
+    in_.push(value);
+}
+
+template <typename T, typename Combine>
+T SlidingWindowQueue<T, Combine>::pop() {
+    if (out_.empty()) {
+        while (!in_.empty()) {
+            out_.push(in_.pop());
+        }
+    }
+    return out_.pop();
+}
+
+template <typename T, typename Combine>
+T SlidingWindowQueue<T, Combine>::aggregate() const {
+    if (in_.empty()) {
+        return out_.aggregate();
+    }
+    if (out_.empty()) {
+        return in_.aggregate();
+    }
+    return combine_(out_.aggregate(), in_.aggregate());
+}
+
+template <typename T, typename Combine>
+size_t SlidingWindowQueue<T, Combine>::size() const {
+    return in_.size() + out_.size();
+}
+
+template <typename T, typename Combine>
+bool SlidingWindowQueue<T, Combine>::empty() const {
+    return size() == 0;
+}
+
+template <typename T, typename Combine>
+void SlidingWindowQueue<T, Combine>::clear() {
+    in_.clear();
+    out_.clear();
+}
@@ -0,0 +1,263 @@
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+struct UnrolledNode {
+    static constexpr size_t kCapacity = 26;
+
+    UnrolledNode* next = nullptr;
+    UnrolledNode* previous = nullptr;
+    uint32_t count = 0;
+    int data[kCapacity];
+
+    UnrolledNode(){};
+};
+
+class UnrolledList {
+private:
+    static constexpr size_t kCapacity = UnrolledNode::kCapacity;
+
+    size_t size_ = 0;
+
+public:
+    UnrolledList() {
+        head = nullptr;
+        tail = head;
+    }
+
+    UnrolledList(int* values, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            if (values[i] >= 2 * 1e9 || values[i] <= -2 * 1e9) {
+                throw std::runtime_error("Wrong Value!");
+            }
+        }
+
+        size_t copied = 0;
+        while (copied < size) {
+            UnrolledNode* node = insertNodeAfter(tail);
+            size_t step = std::min(kCapacity, size - copied);
+
+            memcpy(node->data, values + copied, step * sizeof(int));
+            node->count = static_cast<uint32_t>(step);
+            copied += step;
+        }
+        size_ = size;
+    }
+
+    UnrolledList(const UnrolledList&) = delete;
+    UnrolledList& operator=(const UnrolledList&) = delete;
+
+    ~UnrolledList() {
+        while (head) {
+            unlinkNode(head);
+        }
+    }
+
+    int size() {
+        return static_cast<int>(size_);
+    }
+
+    void pushBack(int value) {
+        checkValue(value);
+        insertAt(size_, value);
+    }
+
+    void pushFront(int value) {
+        checkValue(value);
+        insertAt(0, value);
+    }
+
+    int pop() {
+        if (!head) {
+            throw std::runtime_error("Can not pop such element!");
+        }
+
+        return eraseAt(0);
+    }
+
+    int pop(size_t position) {
+        if (position + 1 >= size_) {
+            throw std::runtime_error("Wrong Position!");
+        }
+
+        return eraseAt(position + 1);
+    }
+
+    void push(int value, size_t position) {
+        if (position >= size_) {
+            throw std::runtime_error("Wrong Position!");
+        }
+        checkValue(value);
+
+        insertAt(position + 1, value);
+    }
+
+    template <typename Function>
+    void forEach(Function function) const {
+        if (!head) {
+            return;
+        }
+
+        UnrolledNode* current = head;
+        do {
+            for (uint32_t i = 0; i < current->count; ++i) {
+                function(current->data[i]);
+            }
+            current = current->next;
+        } while (current != head);
+    }
+
+    UnrolledNode* head{};
+    UnrolledNode* tail{};
+
+private:
+    static void checkValue(int value) {
+        if (value > 2 * 1e9 || value < -2 * 1e9) {
+            throw std::runtime_error("Wrong Value!");
+        }
+    }
+
+    UnrolledNode* insertNodeAfter(UnrolledNode* node) {
+        UnrolledNode* new_node = new UnrolledNode;
+
+        if (!head) {
+            head = tail = new_node;
+            new_node->next = new_node;
+            new_node->previous = new_node;
+            return new_node;
+        }
+
+        new_node->previous = node;
+        new_node->next = node->next;
+        node->next->previous = new_node;
+        node->next = new_node;
+
+        if (node == tail) {
+            tail = new_node;
+        }
+        return new_node;
+    }
+
+    UnrolledNode* insertNodeBefore(UnrolledNode* node) {
+        UnrolledNode* new_node = insertNodeAfter(node->previous);
+
+        if (node == head) {
+            if (tail == new_node) {
+                tail = new_node->previous;
+            }
+            head = new_node;
+        }
+        return new_node;
+    }
+
+    void unlinkNode(UnrolledNode* node) {
+        if (node == head && node == tail) {
+            head = tail = nullptr;
+        } else {
+            node->previous->next = node->next;
+            node->next->previous = node->previous;
+
+            if (node == head) {
+                head = node->next;
+            }
+            if (node == tail) {
+                tail = node->previous;
+            }
+        }
+
+        delete node;
+    }
+
+    UnrolledNode* locate(size_t index, size_t* offset) {
+        if (index < size_ / 2) {
+            UnrolledNode* current = head;
+            while (index >= current->count) {
+                index -= current->count;
+                current = current->next;
+            }
+            *offset = index;
+            return current;
+        }
+
+        size_t remaining = size_ - index;
+        UnrolledNode* current = tail;
+        while (remaining > current->count) {
+            remaining -= current->count;
+            current = current->previous;
+        }
+        *offset = current->count - remaining;
+        return current;
+    }
+
+    void insertAt(size_t index, int value) {
+        UnrolledNode* node = nullptr;
+        size_t offset = 0;
+
+        if (!head) {
+            node = insertNodeAfter(nullptr);
+        } else if (index == size_) {
+            node = tail;
+            if (node->count == kCapacity) {
+                node = insertNodeAfter(tail);
+            }
+            offset = node->count;
+        } else if (index == 0 && head->count == kCapacity) {
+            node = insertNodeBefore(head);
+        } else {
+            node = locate(index, &offset);
+
+            if (node->count == kCapacity) {
+                size_t half = kCapacity / 2;
+                UnrolledNode* right = insertNodeAfter(node);
+
+                memcpy(right->data, node->data + half, (kCapacity - half) * sizeof(int));
+                right->count = static_cast<uint32_t>(kCapacity - half);
+                node->count = static_cast<uint32_t>(half);
+
+                if (offset > half) {
+                    node = right;
+                    offset -= half;
+                }
+            }
+        }
+
+        memmove(node->data + offset + 1, node->data + offset, (node->count - offset) * sizeof(int));
+        node->data[offset] = value;
+        ++node->count;
+        ++size_;
+    }
+
+    int eraseAt(size_t index) {
+        size_t offset = 0;
+        UnrolledNode* node = locate(index, &offset);
+
+        int value_to_return = node->data[offset];
+        memmove(node->data + offset, node->data + offset + 1,
+                (node->count - offset - 1) * sizeof(int));
+        --node->count;
+        --size_;
+
+        if (node->count == 0) {
+            unlinkNode(node);
+        } else if (node->count * 2 < kCapacity) {
+            mergeNeighbours(node);
+        }
+
+        return value_to_return;
+    }
+
+    void mergeNeighbours(UnrolledNode* node) {
+        if (node != tail && node->count + node->next->count <= kCapacity) {
+            UnrolledNode* next = node->next;
+            memcpy(node->data + node->count, next->data, next->count * sizeof(int));
+            node->count += next->count;
+            unlinkNode(next);
+        } else if (node != head && node->previous->count + node->count <= kCapacity) {
+            UnrolledNode* previous = node->previous;
+            memcpy(previous->data + previous->count, node->data, node->count * sizeof(int));
+            previous->count += node->count;
+            unlinkNode(node);
+        }
+    }
+};
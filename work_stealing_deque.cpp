@@ -0,0 +1,380 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity = 64);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque();
+
+    void push(T value);
+
+    std::optional<T> pop();
+
+    std::optional<T> steal();
+
+    size_t size() const;
+
+    bool empty() const;
+
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "deque slots are read racily by thieves");
+
+    struct Array {
+        int64_t capacity;
+        int64_t mask;
+        std::atomic<T>* buffer;
+
+        explicit Array(int64_t n) : capacity(n), mask(n - 1), buffer(new std::atomic<T>[n]) {
+        }
+
+        ~Array() {
+            delete[] buffer;
+        }
+
+        T get(int64_t i) const {
+            return buffer[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, T value) {
+            buffer[i & mask].store(value, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Array*> array_;
+
+    std::vector<Array*> retired_;
+
+    Array* grow(Array* array, int64_t bottom, int64_t top);
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    array_.store(new Array(static_cast<int64_t>(rounded)), std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    delete array_.load(std::memory_order_relaxed);
+    for (Array* array : retired_) {
+        delete array;
+    }
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(Array* array, int64_t bottom,
+                                                                   int64_t top) {
+    Array* bigger = new Array(array->capacity * 2);
+    for (int64_t i = top; i < bottom; ++i) {
+        bigger->put(i, array->get(i));
+    }
+
+    // Thieves may still be reading the old array, so it lives until the deque dies.
+    retired_.push_back(array);
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+template <typename T>
+void WorkStealingDeque<T>::push(T value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+
+    if (bottom - top > array->capacity - 1) {
+        array = grow(array, bottom, top);
+    }
+
+    array->put(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    std::optional<T> value = array->get(bottom);
+    if (top == bottom) {
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            value = std::nullopt;
+        }
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return value;
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+        return std::nullopt;
+    }
+
+    Array* array = array_.load(std::memory_order_acquire);
+    T value = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+template <typename T>
+size_t WorkStealingDeque<T>::size() const {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::empty() const {
+    return size() == 0;
+}
+
+class TaskGroup {
+public:
+    TaskGroup(){};
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+    friend class ThreadPool;
+
+    std::atomic<size_t> pending_{0};
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    void spawn(TaskGroup& group, std::function<void()> function);
+
+    void wait(TaskGroup& group);
+
+    size_t size() const;
+
+private:
+    struct Task {
+        std::function<void()> function;
+        TaskGroup* group;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    std::vector<Worker*> workers_;
+
+    std::mutex injection_mutex_;
+    std::deque<Task*> injection_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_up_;
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<bool> stop_{false};
+
+    static thread_local ThreadPool* current_pool_;
+    static thread_local size_t current_index_;
+
+    void workerLoop(size_t index);
+    Task* findTask(size_t index);
+    void run(Task* task);
+    void notify();
+};
+
+thread_local ThreadPool* ThreadPool::current_pool_ = nullptr;
+thread_local size_t ThreadPool::current_index_ = 0;
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(new Worker);
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
+    }
+    wake_up_.notify_all();
+
+    for (Worker* worker : workers_) {
+        worker->thread.join();
+    }
+    for (Worker* worker : workers_) {
+        while (std::optional<Task*> task = worker->deque.pop()) {
+            delete *task;
+        }
+        delete worker;
+    }
+    for (Task* task : injection_) {
+        delete task;
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers_.size();
+}
+
+void ThreadPool::spawn(TaskGroup& group, std::function<void()> function) {
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    Task* task = new Task{std::move(function), &group};
+
+    if (current_pool_ == this) {
+        workers_[current_index_]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        injection_.push_back(task);
+    }
+    notify();
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    size_t index = current_pool_ == this ? current_index_ : workers_.size();
+
+    while (group.pending_.load(std::memory_order_acquire) != 0) {
+        Task* task = findTask(index);
+        if (task != nullptr) {
+            run(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::notify() {
+    if (sleeping_.load(std::memory_order_seq_cst) != 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        wake_up_.notify_one();
+    }
+}
+
+void ThreadPool::run(Task* task) {
+    task->function();
+    task->group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    delete task;
+}
+
+ThreadPool::Task* ThreadPool::findTask(size_t index) {
+    if (index < workers_.size()) {
+        if (std::optional<Task*> task = workers_[index]->deque.pop()) {
+            return *task;
+        }
+    }
+
+    size_t victims = workers_.size();
+    size_t start = index < victims ? index + 1 : 0;
+    for (size_t i = 0; i < victims; ++i) {
+        size_t victim = (start + i) % victims;
+        if (victim == index) {
+            continue;
+        }
+        if (std::optional<Task*> task = workers_[victim]->deque.steal()) {
+            return *task;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(injection_mutex_);
+    if (injection_.empty()) {
+        return nullptr;
+    }
+    Task* task = injection_.front();
+    injection_.pop_front();
+    return task;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    current_pool_ = this;
+    current_index_ = index;
+
+    int idle_rounds = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        Task* task = findTask(index);
+        if (task != nullptr) {
+            run(task);
+            idle_rounds = 0;
+            continue;
+        }
+
+        if (++idle_rounds < 64) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        wake_up_.wait_for(lock, std::chrono::milliseconds(1));
+        sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+        idle_rounds = 0;
+    }
+
+    current_pool_ = nullptr;
+}
+
+void parallelMergeSort(int* begin, int* end, int* buffer, ThreadPool& pool) {
+    const std::ptrdiff_t sequential_cutoff = 4096;
+    if (end - begin <= sequential_cutoff) {
+        std::sort(begin, end);
+        return;
+    }
+
+    int* middle = begin + (end - begin) / 2;
+    int* buffer_middle = buffer + (middle - begin);
+
+    TaskGroup group;
+    pool.spawn(group, [=, &pool] { parallelMergeSort(begin, middle, buffer, pool); });
+    parallelMergeSort(middle, end, buffer_middle, pool);
+    pool.wait(group);
+
+    std::merge(begin, middle, middle, end, buffer);
+    std::copy(buffer, buffer + (end - begin), begin);
+}
+
+void parallelMergeSort(int* begin, int* end, ThreadPool& pool) {
+    std::vector<int> buffer(end - begin);
+    parallelMergeSort(begin, end, buffer.data(), pool);
+}